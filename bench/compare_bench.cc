@@ -0,0 +1,113 @@
+//=============================================================================
+//
+// File: bench/compare_bench.cc
+//
+// Times nrOfSameChars() and sameChars() with each compare kernel that the
+// CPU supports, for short and long matches, and checks that all kernels give
+// the same results.
+//
+//=============================================================================
+
+#include <chrono>
+#include <cstdio>   // printf
+#include <cstdlib>  // rand
+#include <vector>
+
+#include "compare.hh"
+#include "file.hh" // SPECIAL_EOF
+
+typedef std::chrono::steady_clock Clock;
+
+static const int MATCH_LENGTHS[] = { 0, 3, 12, 40, 100, 300, 1000, 5000 };
+static const int NR_OF_LENGTHS = sizeof(MATCH_LENGTHS) / sizeof(int);
+static const int NR_OF_PAIRS   = 1000;
+static const int TEXT_LENGTH   = 6000;
+
+struct Pair
+{
+    const char* a;
+    const char* b;
+};
+
+// Creates pairs of texts that have the given number of equal characters
+// followed by a difference. Every tenth pair has a SPECIAL_EOF in the middle
+// of the equal characters instead.
+static std::vector<Pair> makePairs(std::vector<char>& buffer, int matchLength)
+{
+    std::vector<Pair> pairs;
+    for (int p = 0; p < NR_OF_PAIRS; ++p)
+    {
+        char* a = &buffer[2 * p * TEXT_LENGTH];
+        char* b = a + TEXT_LENGTH;
+        for (int i = 0; i < TEXT_LENGTH - 1; ++i)
+            a[i] = b[i] = 'a' + std::rand() % 26;
+        a[TEXT_LENGTH - 1] = b[TEXT_LENGTH - 1] = SPECIAL_EOF;
+        b[matchLength] = (a[matchLength] == 'x') ? 'y' : 'x';
+        if (p % 10 == 0 && matchLength > 1)
+            a[matchLength / 2] = b[matchLength / 2] = SPECIAL_EOF;
+        pairs.push_back(Pair{ a, b });
+    }
+    return pairs;
+}
+
+int main()
+{
+    const CompareKernel kernels[] = { SCALAR, SSE2, AVX2, AVX512 };
+
+    std::vector<char> buffer(2 * NR_OF_PAIRS * TEXT_LENGTH + COMPARE_PADDING);
+    std::vector<int>  expected(NR_OF_LENGTHS * NR_OF_PAIRS * 3);
+    bool              allSame = true;
+
+    std::printf("kernel    length  nrOfSame ns  sameAs ns\n");
+    for (int k = 0; k < 4; ++k)
+    {
+        if (not selectCompareKernel(kernels[k]))
+            continue;
+        for (int l = 0; l < NR_OF_LENGTHS; ++l)
+        {
+            std::srand(l);
+            const std::vector<Pair> pairs = makePairs(buffer,
+                                                      MATCH_LENGTHS[l]);
+            const int lastIx = MATCH_LENGTHS[l] > 0 ? MATCH_LENGTHS[l] - 1 : 0;
+            int* results = &expected[l * NR_OF_PAIRS * 3];
+
+            Clock::time_point start = Clock::now();
+            for (int p = 0; p < NR_OF_PAIRS; ++p)
+            {
+                const int n = nrOfSameChars(pairs[p].a, pairs[p].b);
+                if (k == 0)
+                    results[p] = n;
+                else if (results[p] != n)
+                    allSame = false;
+            }
+            const double nrOfSameNs =
+                std::chrono::duration<double, std::nano>(Clock::now() -
+                                                         start).count();
+
+            start = Clock::now();
+            for (int p = 0; p < NR_OF_PAIRS; ++p)
+            {
+                const int same1 = sameChars(pairs[p].a, pairs[p].b, lastIx);
+                const int same2 = sameChars(pairs[p].a, pairs[p].b,
+                                            lastIx + 1);
+                int* r = &results[NR_OF_PAIRS + 2 * p];
+                if (k == 0)
+                {
+                    r[0] = same1;
+                    r[1] = same2;
+                }
+                else if (r[0] != same1 || r[1] != same2)
+                    allSame = false;
+            }
+            const double sameNs =
+                std::chrono::duration<double, std::nano>(Clock::now() -
+                                                         start).count();
+
+            std::printf("%-8s %7d %12.1f %10.1f\n", compareKernelName(),
+                        MATCH_LENGTHS[l], nrOfSameNs / NR_OF_PAIRS,
+                        sameNs / (2 * NR_OF_PAIRS));
+        }
+    }
+    std::printf(allSame ? "All kernels agree.\n" : "Kernels DISAGREE!\n");
+    return allSame ? 0 : 1;
+}
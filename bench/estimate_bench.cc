@@ -0,0 +1,89 @@
+//=============================================================================
+//
+// File: bench/estimate_bench.cc
+//
+// Compares the estimated total duplication with the exact one that -t finds,
+// and the time each of them takes. Takes the same arguments as dupfind, e.g.
+// -t or -T followed by files.
+//
+//=============================================================================
+
+#include <chrono>
+#include <cmath>   // fabs
+#include <cstdio>  // printf
+#include <cstring> // strlen
+#include <vector>
+
+#include "bookmark_container.hh"
+#include "duplication.hh"
+#include "options.hh"
+#include "parser.hh"
+#include "repeat_enumerator.hh"
+
+typedef std::chrono::steady_clock Clock;
+
+static const size_t NR_OF_SAMPLES[] = { 1000, 10000, 100000 };
+
+static double secondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    options.parse(argc, argv);
+
+    BookmarkContainer container;
+    Parser            parser(container);
+    const char*       processed = parser.process(options.wordMode);
+    const size_t      length    = strlen(processed);
+    const size_t      minLength = options.minLength;
+
+    std::printf("%zu bookmarks, %zu characters, -m%zu\n", container.size(),
+                length, minLength);
+    std::printf("method        samples  duplication %%   seconds\n");
+
+    // The estimate is made before the bookmarks are sorted.
+    std::vector<double> shares;
+    std::vector<double> margins;
+    for (size_t n = 0; n < sizeof NR_OF_SAMPLES / sizeof *NR_OF_SAMPLES; ++n)
+    {
+        const Clock::time_point start = Clock::now();
+        double                  margin;
+        const double            share =
+            container.estimateDuplication(minLength, NR_OF_SAMPLES[n], margin);
+        std::printf("estimate   %10zu  %6.2f +- %4.2f  %8.3f\n",
+                    NR_OF_SAMPLES[n], 100 * share, 100 * margin,
+                    secondsSince(start));
+        shares.push_back(share);
+        margins.push_back(margin);
+    }
+
+    // Finds all duplications just like dupfind -t, without reporting them.
+    const Clock::time_point start = Clock::now();
+    container.removeUnique(minLength * options.proximityFactor / 100);
+    container.sort(options, minLength);
+    RepeatEnumerator    enumerator(container, minLength,
+                                   options.proximityFactor);
+    Duplication         duplication;
+    std::vector<size_t> instances;
+    size_t              total = 0;
+    while (enumerator.next(duplication, instances))
+        total += duplication.longestSame * duplication.instances;
+    const double exact = double(total) / length;
+    std::printf("exact                   %6.2f          %8.3f\n", 100 * exact,
+                secondsSince(start));
+
+    bool allWithin = true;
+    for (size_t n = 0; n < shares.size(); ++n)
+        if (std::fabs(shares[n] - exact) > margins[n] + 0.01)
+        {
+            std::printf("The estimate from %zu samples is off by more than "
+                        "its margin plus one percentage point.\n",
+                        NR_OF_SAMPLES[n]);
+            allWithin = false;
+        }
+    delete [] processed;
+    return allWithin ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+//=============================================================================
+//
+// File: bench/layout_bench.cc
+//
+// Compares sorting and scanning of bookmarks in the container, which keeps
+// the first characters of each bookmark inline, with a plain array of
+// Bookmark objects that have to look at the processed text for every
+// comparison. Takes the same file arguments as dupfind.
+//
+//=============================================================================
+
+#include <algorithm> // stable_sort
+#include <chrono>
+#include <cstdio>    // printf
+#include <cstring>   // strlen
+#include <vector>
+
+#include "bookmark.hh"
+#include "bookmark_container.hh"
+#include "options.hh"
+#include "parser.hh"
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() -
+                                                     start).count();
+}
+
+// The scan that Dupfind::findWorst() does, on a plain array.
+static size_t scanArray(const std::vector<Bookmark>& marks, const char* end)
+{
+    size_t longestSame = 0;
+    for (size_t ix = 0; ix + 1 < marks.size(); ++ix)
+        if (marks[ix].sameAs(marks[ix + 1], longestSame, end))
+            longestSame = std::max(longestSame,
+                                   marks[ix].nrOfSame(marks[ix + 1]));
+    return longestSame;
+}
+
+// The scan that Dupfind::findWorst() does, on the container.
+static size_t scanContainer(const BookmarkContainer& container,
+                            const char*              end)
+{
+    size_t longestSame = 0;
+    for (size_t ix = 0; ix + 1 < container.size(); ++ix)
+        if (container.same(ix, ix + 1, longestSame, end))
+            longestSame = std::max(longestSame,
+                                   container.nrOfSame(ix, ix + 1));
+    return longestSame;
+}
+
+int main(int argc, char* argv[])
+{
+    const int NR_OF_SCANS = 10;
+
+    Options options;
+    options.parse(argc, argv);
+
+    BookmarkContainer container;
+    Parser            parser(container);
+    const char*       processed = parser.process(options.wordMode);
+    const char*       end       = processed + strlen(processed);
+
+    std::vector<Bookmark> marks;
+    for (size_t ix = 0; ix < container.size(); ++ix)
+        marks.push_back(container[ix]);
+
+    std::printf("%zu bookmarks, %zu characters of processed text\n",
+                container.size(), strlen(processed));
+    std::printf("layout       sort ms  scan ms  longest\n");
+
+    Clock::time_point start = Clock::now();
+    std::stable_sort(marks.begin(), marks.end());
+    const double arraySort = msSince(start);
+    start = Clock::now();
+    size_t arrayLongest = 0;
+    for (int i = 0; i < NR_OF_SCANS; ++i)
+        arrayLongest = scanArray(marks, end);
+    std::printf("array     %10.1f %8.1f %8zu\n", arraySort,
+                msSince(start) / NR_OF_SCANS, arrayLongest);
+
+    options.nrOfThreads = 1;
+    options.lowMemory   = false;
+    start = Clock::now();
+    container.sort(options);
+    const double containerSort = msSince(start);
+    start = Clock::now();
+    size_t containerLongest = 0;
+    for (int i = 0; i < NR_OF_SCANS; ++i)
+        containerLongest = scanContainer(container, end);
+    std::printf("container %10.1f %8.1f %8zu\n", containerSort,
+                msSince(start) / NR_OF_SCANS, containerLongest);
+
+    delete [] processed;
+    return (arrayLongest == containerLongest) ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+//=============================================================================
+//
+// File: bench/memory_bench.cc
+//
+// Measures the peak resident set size and the time of whole dupfind runs,
+// from parsing through removing unique bookmarks and sorting to searching,
+// by default, with -l and with a memory limit that makes it sort in runs on
+// disk. Takes the same arguments as dupfind.
+//
+// The dupfind next to the bench directory is measured. If DUPFIND_BASELINE
+// names another build, e.g. one from before the bookmarks were made compact,
+// it is measured first and the others are compared with it. Otherwise they
+// are compared with the default run.
+//
+// Each run is a child process of its own, so its peak is not counted from
+// the size of the bench, and wait4 gives the usage of that child alone,
+// where getrusage(RUSAGE_CHILDREN) would give the biggest peak so far.
+//
+//=============================================================================
+
+#include <chrono>
+#include <cstdio>       // printf
+#include <cstdlib>      // getenv, exit
+#include <string>
+#include <vector>
+#include <fcntl.h>      // open
+#include <sys/resource.h>
+#include <sys/wait.h>   // wait4
+#include <unistd.h>     // fork, execv, dup2
+
+typedef std::chrono::steady_clock Clock;
+
+struct Run
+{
+    double seconds;
+    double peakMb;
+};
+
+// Runs the program with the arguments and the extra flags, with its output
+// thrown away, and returns how long it took and its peak memory.
+static Run measure(const std::string& program, int argc, char* argv[],
+                   const std::vector<const char*>& flags)
+{
+    std::vector<char*> args;
+    args.push_back(const_cast<char*>(program.c_str()));
+    for (size_t f = 0; f < flags.size(); ++f)
+        args.push_back(const_cast<char*>(flags[f]));
+    for (int i = 1; i < argc; ++i)
+        args.push_back(argv[i]);
+    args.push_back(0);
+
+    const Clock::time_point start = Clock::now();
+    const pid_t             pid   = fork();
+    if (pid == 0)
+    {
+        const int null = open("/dev/null", O_WRONLY);
+        dup2(null, 1);
+        dup2(null, 2);
+        execv(program.c_str(), &args[0]);
+        std::_Exit(127);
+    }
+    int           status = 0;
+    struct rusage usage;
+    wait4(pid, &status, 0, &usage);
+    if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+        std::fprintf(stderr, "%s failed\n", program.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+    const Run run = {
+        std::chrono::duration<double>(Clock::now() - start).count(),
+        usage.ru_maxrss / 1024.0
+    };
+    return run;
+}
+
+static void print(const char* name, const Run& run, const Run& reference)
+{
+    std::printf("%-14s %10.2f %10.1f %9.0f %%\n", name, run.seconds,
+                run.peakMb, 100 * run.peakMb / reference.peakMb);
+}
+
+int main(int argc, char* argv[])
+{
+    // The bench is in the bench directory of the build.
+    const std::string self    = argv[0];
+    const size_t      slash   = self.find_last_of('/');
+    const std::string program = (slash == std::string::npos) ?
+        "../dupfind" : self.substr(0, slash) + "/../dupfind";
+    const char*       baseline = std::getenv("DUPFIND_BASELINE");
+    const bool        hasBaseline = baseline != 0 && *baseline != '\0';
+
+    std::printf("run               seconds    peak MB   of %s\n",
+                hasBaseline ? "baseline" : "default");
+    std::fflush(stdout);
+
+    const std::vector<const char*> none;
+    const Run base = hasBaseline ? measure(baseline, argc, argv, none) :
+                                   measure(program, argc, argv, none);
+    if (hasBaseline)
+        print("baseline", base, base);
+
+    struct Variant
+    {
+        const char* name;
+        const char* flags[2];
+    };
+    const Variant variants[] = {
+        { "default",       { 0, 0 } },
+        { "low memory",    { "-l", 0 } },
+        { "mem-limit 1M",  { "--mem-limit", "1" } },
+    };
+    for (size_t v = 0; v < sizeof variants / sizeof *variants; ++v)
+    {
+        std::vector<const char*> flags;
+        for (int f = 0; f < 2 && variants[v].flags[f]; ++f)
+            flags.push_back(variants[v].flags[f]);
+        const Run run = (v == 0 && not hasBaseline) ?
+            base : measure(program, argc, argv, flags);
+        print(variants[v].name, run, base);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+//=============================================================================
+//
+// File: bench/sort_bench.cc
+//
+// Measures how the bookmark sorting scales with the number of threads. Takes
+// the same arguments as dupfind, e.g. "sort_bench -e .rb" or, for the sort
+// that saves memory, "sort_bench -l -e .rb".
+//
+//=============================================================================
+
+#include <chrono>
+#include <cstdio>   // printf
+#include <cstring>  // strlen
+
+#include "bookmark.hh"
+#include "bookmark_container.hh"
+#include "options.hh"
+#include "parser.hh"
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    options.parse(argc, argv);
+
+    BookmarkContainer container;
+    Parser            parser(container);
+    const char*       processed = parser.process(options.wordMode);
+
+    std::printf("%zu bookmarks, %zu characters of processed text\n",
+                container.size(), strlen(processed));
+    std::printf("threads     ms  speedup\n");
+
+    double serialTime = 0;
+    for (int nrOfThreads = 1; nrOfThreads <= 64; nrOfThreads *= 2)
+    {
+        BookmarkContainer copy = container;
+        options.nrOfThreads = nrOfThreads;
+        auto start = std::chrono::steady_clock::now();
+        copy.sort(options);
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (nrOfThreads == 1)
+            serialTime = elapsed.count();
+        std::printf("%7d %6.1f %8.2f\n", nrOfThreads, elapsed.count(),
+                    serialTime / elapsed.count());
+    }
+    delete [] processed;
+    return 0;
+}
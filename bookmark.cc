@@ -1,4 +1,5 @@
 #include "bookmark.hh"
+#include "compare.hh" // nrOfSameChars, sameChars
 #include "options.hh"
 #include "duplication.hh"
 #include "file.hh" // readFileIntoString
@@ -12,8 +13,6 @@ using std::cout;
 using std::endl;
 using std::string;
 
-static const char* order(int);
-
 int                               Bookmark::theirTotalNrOfLines = 0;
 std::vector<Bookmark::FileRecord> Bookmark::theirFileRecords;
 string                            Bookmark::theirOriginalString;
@@ -47,7 +46,7 @@ void Bookmark::report(const Duplication& duplication,
 }
 
 // Returns the correct suffix for strings like 1st, 2nd, 3rd, 4th, etc.
-static const char* order(int nr)
+const char* Bookmark::order(int nr)
 {
     if      (nr % 10 == 1 && nr % 100 != 11) return "st";
     else if (nr % 10 == 2 && nr % 100 != 12) return "nd";
@@ -60,14 +59,9 @@ bool Bookmark::operator<(const Bookmark& another) const // Used in sorting.
     return strcmp(another.itsProcessedText, itsProcessedText) < 0;
 }
 
-int Bookmark::nrOfSame(Bookmark b) const
+size_t Bookmark::nrOfSame(Bookmark b) const
 {
-    int index = 0;
-    for (; itsProcessedText[index] == b.itsProcessedText[index]; ++index)
-        // The characters are equal so we only have to check one of them.
-        if (itsProcessedText[index] == SPECIAL_EOF)
-            break;
-    return index;
+    return nrOfSameChars(itsProcessedText, b.itsProcessedText);
 }
 
 /**
@@ -76,7 +70,7 @@ int Bookmark::nrOfSame(Bookmark b) const
  * characters and move on to the next comparison.
  */
 bool
-Bookmark::sameAs(Bookmark b, int nrOfCharacters, const char* end) const
+Bookmark::sameAs(Bookmark b, size_t nrOfCharacters, const char* end) const
 {
     if (&itsProcessedText[nrOfCharacters] >= end ||
         &b.itsProcessedText[nrOfCharacters] >= end)
@@ -84,34 +78,43 @@ Bookmark::sameAs(Bookmark b, int nrOfCharacters, const char* end) const
         return false;
     }
 
-    for (int i = nrOfCharacters; i >= 0; --i)
-        if (itsProcessedText[i] != b.itsProcessedText[i])
-            return false;
+    return sameChars(itsProcessedText, b.itsProcessedText, nrOfCharacters);
+}
 
-    return true;
+void Bookmark::addFile(const string& fileName, FileSet set)
+{
+    addFile(fileName, readFileIntoString(fileName.c_str()), set);
 }
 
-void Bookmark::addFile(const string& fileName)
+void Bookmark::addFile(const string& fileName,
+                       const string& text,
+                       FileSet       set)
 {
-    theirOriginalString += readFileIntoString(fileName.c_str());
+    theirOriginalString += text;
     theirFileRecords.push_back(FileRecord(fileName,
-                                          theirOriginalString.length()));
+                                          theirOriginalString.length(), set));
 }
 
-int Bookmark::details(int        processedLength,
+void Bookmark::clearFiles()
+{
+    theirFileRecords.clear();
+    theirOriginalString.clear();
+}
+
+int Bookmark::details(size_t     processedLength,
                       DetailType detailType,
                       bool       wordMode) const
 {
     const char* orig = theirOriginalString.c_str() + itsOriginalIndex;
     if (not wordMode)
     {
-        while (orig > theirOriginalString.c_str() && *orig != '\n')
+        while (orig > theirOriginalString.c_str() && orig[-1] != '\n')
             --orig; // to include leading whitespace in printout
-        ++orig;
     }
     int  count     = 1;
     bool blankLine = true;
-    for (int pi = 0; pi < processedLength; ++pi, ++orig)
+    for (size_t pi = 0; pi < processedLength; ++pi, ++orig)
+    {
         for (; *orig != 0 && *orig != SPECIAL_EOF; ++orig)
         {
             if (detailType == PRINT_LINES)
@@ -132,6 +135,11 @@ int Bookmark::details(int        processedLength,
             if (*orig == t || (isspace(t) && isspace(*orig)))
                 break;
         }
+        // A duplication ends within its file, unless it was read from a
+        // damaged index.
+        if (*orig == 0 || *orig == SPECIAL_EOF)
+            break;
+    }
     if (detailType == PRINT_LINES)
         cout << endl;
     return count;
@@ -139,29 +147,42 @@ int Bookmark::details(int        processedLength,
 
 std::ostream& operator<<(std::ostream& os, const Bookmark& b)
 {
-    int recIx = 0;
-    while (Bookmark::theirFileRecords[recIx].endIx <= b.itsOriginalIndex)
-        ++recIx;
-
+    const size_t recIx = Bookmark::fileNrOf(b.itsOriginalIndex);
     os << Bookmark::theirFileRecords[recIx].fileName << ":"
        << Bookmark::lineNr(b.itsOriginalIndex, recIx);
     return os;
 }
 
-int Bookmark::lineNr(int offset, int index)
+int Bookmark::lineNr(size_t offset, size_t index)
 {
-    const int start = (index == 0) ? 0 : theirFileRecords[index - 1].endIx;
+    const size_t start = (index == 0) ? 0 : theirFileRecords[index - 1].endIx;
     int result = 1;
-    for (int i = start; i < offset; ++i)
+    for (size_t i = start; i < offset; ++i)
         if (theirOriginalString[i] == '\n')
             ++result;
     return result;
 }
 
-const string Bookmark::getFileName(int i)
+const string Bookmark::getFileName(size_t i)
 {
-    int recIx = 0;
-    while (Bookmark::theirFileRecords[recIx].endIx <= i)
-        ++recIx;
-    return Bookmark::theirFileRecords[recIx].fileName;  
+    return Bookmark::theirFileRecords[fileNrOf(i)].fileName;
+}
+
+/**
+ * Returns the number of the file that the original index is in. The files
+ * are searched by halves, since the parser asks for every character.
+ */
+size_t Bookmark::fileNrOf(size_t i)
+{
+    size_t low  = 0;
+    size_t high = theirFileRecords.size() - 1;
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (theirFileRecords[middle].endIx <= i)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
 }
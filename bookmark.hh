@@ -14,16 +14,24 @@ class Options;
  */
 class Bookmark
 {
+public:
+    // When only duplications between two sets of files are wanted, each file
+    // is in one of them.
+    enum FileSet { NO_SET, LEFT_SET, RIGHT_SET };
+
+private:
     struct FileRecord
     {
-        FileRecord(const std::string& n, int i): fileName(n), endIx(i) {}
+        FileRecord(const std::string& n, size_t i, FileSet s):
+            fileName(n), endIx(i), set(s) {}
         std::string fileName;
-        int         endIx; // Position right after the final char of the file.
+        size_t      endIx; // Position right after the final char of the file.
+        FileSet     set;
     };
 
 public:
-    Bookmark(int i = 0, const char* p = 0): itsOriginalIndex(i),
-                                            itsProcessedText(p) {}
+    Bookmark(size_t i = 0, const char* p = 0): itsOriginalIndex(i),
+                                               itsProcessedText(p) {}
 
     /**
      * Reports one instance of duplication and optionally prints the duplicated
@@ -42,45 +50,93 @@ public:
 
     bool operator<(const Bookmark& another) const; // Used in sorting.
 
+    // The number of the file that the bookmark is in.
+    size_t fileNr() const { return fileNrOf(itsOriginalIndex); }
+
+    // The lines that the given number of processed characters from the
+    // bookmark are on, not counting blank ones.
+    int nrOfLines(size_t processedLength, bool wordMode) const
+    {
+        return details(processedLength, COUNT_LINES, wordMode);
+    }
+
     /**
      * How many characters are equal when comparing the bookmark to
      * another bookmark?
      */
-    int nrOfSame(Bookmark b) const;
+    size_t nrOfSame(Bookmark b) const;
 
     /**
      * Used for optimization purposes. By comparing strings backwards we can
      * find out quickly if the two strings are not equal in the given number of
      * characters and move on to the next comparison.
      */
-    bool sameAs(Bookmark b, int nrOfCharacters, const char* end) const;
+    bool sameAs(Bookmark b, size_t nrOfCharacters, const char* end) const;
 
     static int getTotalNrOfLines() { return theirTotalNrOfLines; }
 
-    static void addFile(const std::string& fileName);
+    static void addFile(const std::string& fileName, FileSet set = NO_SET);
+
+    // Adds a file whose text, ending with a SPECIAL_EOF, is known already.
+    static void addFile(const std::string& fileName,
+                        const std::string& text,
+                        FileSet            set);
+
+    static void clearFiles();
 
     static size_t totalLength() { return theirOriginalString.length(); }
 
-    static const char& getChar(int i) { return theirOriginalString[i]; }
+    static const char& getChar(size_t i) { return theirOriginalString[i]; }
+
+    static const std::string getFileName(size_t i);
 
-    static const std::string getFileName(int i);
+    // The suffix of an ordinal number, e.g., "nd" for 2.
+    static const char* order(int nr);
+
+    static size_t nrOfFiles() { return theirFileRecords.size(); }
+
+    static FileSet setOf(size_t fileNr)
+    {
+        return theirFileRecords[fileNr].set;
+    }
+
+    // The name of a file by its number, in the order the files were added.
+    static const std::string& fileName(size_t fileNr)
+    {
+        return theirFileRecords[fileNr].fileName;
+    }
+
+    // The original text of a file, with its SPECIAL_EOF.
+    static std::string fileText(size_t fileNr)
+    {
+        const size_t begin = (fileNr == 0) ? 0 : fileEnd(fileNr - 1);
+        return theirOriginalString.substr(begin, fileEnd(fileNr) - begin);
+    }
+
+    // Where in the original text the file ends, right after its SPECIAL_EOF.
+    static size_t fileEnd(size_t fileNr)
+    {
+        return theirFileRecords[fileNr].endIx;
+    }
 
 private:
     friend std::ostream& operator<<(std::ostream& os, const Bookmark& b);
     friend class BookmarkContainer;
+    friend class IndexFile;
 
     enum DetailType { PRINT_LINES, COUNT_LINES };
 
     int
-    details(int processedLength, DetailType detailType, bool wordMode) const;
+    details(size_t processedLength, DetailType detailType, bool wordMode) const;
 
-    static int lineNr(int offset, int index);
+    static int    lineNr(size_t offset, size_t index);
+    static size_t fileNrOf(size_t i);
 
     static int                     theirTotalNrOfLines;
     static std::vector<FileRecord> theirFileRecords;
     static std::string             theirOriginalString;
 
-    int         itsOriginalIndex;
+    size_t      itsOriginalIndex;
     const char* itsProcessedText;
 };
 
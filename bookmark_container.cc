@@ -1,56 +1,1302 @@
 #include "bookmark.hh"
 #include "bookmark_container.hh"
+#include "compare.hh" // nrOfSameChars, sameChars
 #include "duplication.hh"
+#include "file.hh"    // SPECIAL_EOF
+#include "options.hh"
+#include "sorted_run.hh"
+#include "suffix_array.hh"
 
-#include <algorithm> // stable_sort, remove_if
-#include <functional> // mem_fun_ref
+#include <algorithm> // equal_range, lower_bound, min, sort, stable_sort, swap,
+                     // upper_bound
+#include <atomic>
+#include <cmath>     // sqrt
+#include <memory>    // unique_ptr
+#include <cstddef>   // ptrdiff_t
+#include <cstring>   // memchr, strchr, strcmp, strlen, strncmp
+#include <functional>
+#include <numeric>   // partial_sum
+#include <queue>     // priority_queue
+#include <random>    // mt19937_64
+#include <thread>
+#include <unordered_map>
+#include <utility>   // move, pair
 
-void BookmarkContainer::report(int                bookmarkIx,
+// Buckets are selected by the first two characters of the processed text.
+static const size_t NR_OF_BUCKETS = 256 * 256;
+
+// Below this size it's not worth starting any threads.
+static const size_t MIN_PARALLEL_SIZE = 1000;
+
+// The text is considered repetitive if at least REPETITIVE_SHARE of the
+// neighbors in a sorted sample of this many bookmarks have SAMPLE_DEPTH
+// characters in common. Bookmarks from different places in the text are
+// seldom neighbors in the sample, so this only happens if most of the text is
+// a few long stretches over and over again. Source trees with many copied
+// files have only a few percent.
+static const size_t SAMPLE_SIZE      = 4096;
+static const size_t SAMPLE_DEPTH     = 4096;
+static const double REPETITIVE_SHARE = 0.5;
+
+// Sorting in memory needs a key and a buffer entry for each bookmark.
+static const size_t SORT_BYTES_PER_BOOKMARK = 32;
+
+// When sorting in runs on disk, this many runs are merged at a time, so that
+// no more files are open and read from at once.
+static const size_t MAX_MERGED_RUNS = 64;
+
+// For the rolling hash of the first characters of the bookmarks, and the
+// FNV-1a hash of their lines.
+static const uint64_t HASH_BASE        = 0x100000001b3ULL;
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+// The number of two-bit counters per bookmark in the filter that bookmarks
+// with unique prefixes are found with. With two counters for each prefix, at
+// most about one in twenty unique ones is kept.
+static const size_t COUNTERS_PER_BOOKMARK = 8;
+
+// For the positions that the duplication is estimated from.
+static const uint64_t ESTIMATE_SEED        = 4711;
+static const size_t   ESTIMATE_FILTER_SIZE = 1 << 22;
+
+static const uint64_t ONES = 0x0101010101010101ULL;
+static const uint64_t LOW7 = 0x7f7f7f7f7f7f7f7fULL;
+
+// Returns the number of leading characters that are the same in two
+// prefixes, which is 8 if the prefixes are equal.
+static size_t nrOfSamePrefixChars(uint64_t a, uint64_t b)
+{
+    return (a == b) ? 8 : __builtin_clzll(a ^ b) / 8;
+}
+
+// Returns the position of the first SPECIAL_EOF in a prefix, or 8 if there is
+// none.
+static size_t eofPosition(uint64_t prefix)
+{
+    const uint64_t v = prefix ^ (ONES * (unsigned char)SPECIAL_EOF);
+    // Sets the high bit of each byte in v that is zero, without carry between
+    // the bytes.
+    const uint64_t zeroBytes = ~(((v & LOW7) + LOW7) | v | LOW7);
+    return (zeroBytes == 0) ? 8 : __builtin_clzll(zeroBytes) / 8;
+}
+
+// Spreads the bits of a hash evenly, since the low bits of the rolling hash
+// only depend on the low bits of the characters. This is the finalizer of
+// SplitMix64.
+static uint64_t mixed(uint64_t hash)
+{
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+// Returns the number of characters from the offset up to the end of its file.
+static size_t toEof(const std::vector<size_t>& eofs, size_t offset)
+{
+    return *std::lower_bound(eofs.begin(), eofs.end(), offset) - offset;
+}
+
+// The sorted order has the greatest string first, so the buckets are numbered
+// in descending order of the first two characters.
+static size_t bucketOf(const char* text)
+{
+    const unsigned char* t = reinterpret_cast<const unsigned char*>(text);
+    return NR_OF_BUCKETS - 1 - ((t[0] == '\0') ? 0 : (t[0] << 8 | t[1]));
+}
+
+// Returns the start of each bucket, plus the end of the last one.
+template <typename T, typename BucketFunction>
+static std::vector<size_t> bucketStarts(const std::vector<T>& v,
+                                        BucketFunction        bucket)
+{
+    std::vector<size_t> starts(NR_OF_BUCKETS + 1, 0);
+    for (size_t ix = 0; ix < v.size(); ++ix)
+        ++starts[bucket(v[ix]) + 1];
+    std::partial_sum(starts.begin(), starts.end(), starts.begin());
+    return starts;
+}
+
+/**
+ * Sorts each bucket with the given function, using the given number of
+ * threads. The biggest buckets are handed out first so that the threads
+ * finish at about the same time.
+ */
+template <typename T, typename SortFunction>
+static void sortBuckets(std::vector<T>&            v,
+                        const std::vector<size_t>& starts,
+                        int                        nrOfThreads,
+                        SortFunction               sortRange)
+{
+    std::vector<size_t> jobs;
+    for (size_t b = 0; b < NR_OF_BUCKETS; ++b)
+        if (starts[b + 1] - starts[b] > 1)
+            jobs.push_back(b);
+    std::sort(jobs.begin(), jobs.end(), [&](size_t a, size_t b) {
+        return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+    });
+
+    std::atomic<size_t> nextJob(0);
+    auto worker = [&]() {
+        for (size_t j = nextJob++; j < jobs.size(); j = nextJob++)
+            sortRange(v.begin() + starts[jobs[j]],
+                      v.begin() + starts[jobs[j] + 1]);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < nrOfThreads; ++t)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+}
+
+// Same order as Bookmark::operator<(), i.e., the greatest string first, but
+// only the first depth characters are compared. Strings that differ later on
+// are then considered equal.
+class BookmarkContainer::TextOrder
+{
+public:
+    TextOrder(const char* text, size_t depth = SIZE_MAX):
+        itsText(text), itsDepth(depth) {}
+
+    template <typename Offset>
+    bool operator()(Offset a, Offset b) const
+    {
+        if (itsDepth == SIZE_MAX)
+            return strcmp(itsText + b, itsText + a) < 0;
+        return strncmp(itsText + b, itsText + a, itsDepth) < 0;
+    }
+
+private:
+    const char*  itsText;
+    const size_t itsDepth;
+};
+
+class BookmarkContainer::KeyOrder
+{
+public:
+    KeyOrder(const char* text, size_t depth):
+        itsText(text),
+        itsDepth(depth),
+        itsPrefixMask((depth >= 8) ? ~0ULL : ~(~0ULL >> (8 * depth))) {}
+
+    template <typename Offset>
+    bool operator()(const SortKey<Offset>& a, const SortKey<Offset>& b) const
+    {
+        if (a.prefix != b.prefix)
+            return (a.prefix & itsPrefixMask) > (b.prefix & itsPrefixMask);
+        // Equal prefixes that contain the terminating null character mean
+        // equal strings.
+        if ((a.prefix & 0xff) == 0 || itsDepth <= 8)
+            return false;
+        const char* textA = itsText + a.offset + 8;
+        const char* textB = itsText + b.offset + 8;
+        if (itsDepth == SIZE_MAX)
+            return strcmp(textB, textA) < 0;
+        return strncmp(textB, textA, itsDepth - 8) < 0;
+    }
+
+private:
+    const char*    itsText;
+    const size_t   itsDepth;
+    const uint64_t itsPrefixMask; // The characters within the depth.
+};
+
+void BookmarkContainer::addBookmark(const Bookmark& bm)
+{
+    const size_t offset = bm.itsProcessedText - itsText;
+    itsMarkOffsets.push_back(offset);
+    itsMarkOriginals.push_back(bm.itsOriginalIndex);
+    itsOffsets.push_back(offset);
+}
+
+/**
+ * Returns the bookmark at the given position in sorted order. The original
+ * index is looked up among the bookmarks in the order they were added, since
+ * their offsets are increasing.
+ */
+Bookmark BookmarkContainer::operator[](size_t ix) const
+{
+    const size_t offset = itsOffsets[ix];
+    const size_t markIx = itsMarkOffsets.upperBound(offset) - 1;
+    return Bookmark(itsMarkOriginals[markIx], itsText + offset);
+}
+
+void BookmarkContainer::report(size_t             bookmarkIx,
                                const Duplication& duplication,
                                int                instanceNr,
                                const Options&     options) const
 {
-    itsBookmarks[bookmarkIx].report(duplication, instanceNr, options);
+    (*this)[bookmarkIx].report(duplication, instanceNr, options);
 }
 
 bool BookmarkContainer::same(size_t a,
                              size_t b,
-                             int longestSame,
+                             size_t longestSame,
                              const char* processedEnd) const
 {
-    return itsBookmarks[a].sameAs(itsBookmarks[b], longestSame, processedEnd);
+    if (hasLcpTable())
+        return nrOfSame(a, b) > longestSame;
+
+    const char* textA = itsText + itsOffsets[a];
+    const char* textB = itsText + itsOffsets[b];
+    if (&textA[longestSame] >= processedEnd ||
+        &textB[longestSame] >= processedEnd)
+    {
+        return false;
+    }
+    if (itsPrefixes.empty())
+        return sameChars(textA, textB, longestSame);
+
+    if (longestSame < 8)
+        return nrOfSamePrefixChars(itsPrefixes[a], itsPrefixes[b]) >
+            longestSame;
+
+    // Beyond the prefix, the character at the far end is the one most likely
+    // to differ, so we compare backwards just like Bookmark::sameAs().
+    return sameChars(textA + 8, textB + 8, longestSame - 8) &&
+        itsPrefixes[a] == itsPrefixes[b];
+}
+
+size_t BookmarkContainer::nrOfSame(size_t a, size_t b, size_t maxSame) const
+{
+    if (not hasLcpTable())
+        return nrOfSameInText(a, b, maxSame);
+
+    const size_t rankA = itsRanks[a];
+    const size_t rankB = itsRanks[b];
+    return std::min(maxSame,
+                    (rankA < rankB) ? itsLcpTable.minimum(rankA, rankB) :
+                                      itsLcpTable.minimum(rankB, rankA));
 }
 
-int BookmarkContainer::nrOfSame(int a, int b) const
+bool BookmarkContainer::samePrefix(size_t a, size_t b, size_t depth) const
 {
-    return itsBookmarks[a].nrOfSame(itsBookmarks[b]);
+    return strncmp(itsText + itsOffsets[a], itsText + itsOffsets[b],
+                   depth) == 0;
 }
 
-void BookmarkContainer::sort()
+void BookmarkContainer::sameRange(size_t  ix,
+                                  size_t  same,
+                                  size_t& first,
+                                  size_t& last) const
 {
-    // std::stable_sort(), which is a merge sort, has proved to be much faster
-    // than std::sort() in this context.
-    std::stable_sort(itsBookmarks.begin(), itsBookmarks.end());
+    // The bookmarks that are left within the range of ranks.
+    const size_t rank = itsRanks[ix];
+    first = itsRanks.lowerBound(itsLcpTable.firstWithSame(rank, same));
+    last  = itsRanks.upperBound(itsLcpTable.lastWithSame(rank, same)) - 1;
+}
+
+/**
+ * The bookmarks are sorted with the greatest text first. The common
+ * characters with the text only grow towards where it would be among them,
+ * so the nearest bookmark on either side that isn't left out is the best on
+ * that side.
+ */
+size_t BookmarkContainer::findLongest(const char* text,
+                                      size_t      skipBegin,
+                                      size_t      skipEnd,
+                                      size_t&     ix) const
+{
+    const size_t length = strchr(text, SPECIAL_EOF) - text;
+    size_t       begin  = 0;
+    size_t       end    = itsOffsets.size();
+    while (begin < end)
+    {
+        const size_t middle = begin + (end - begin) / 2;
+        if (strncmp(itsText + itsOffsets[middle], text, length) > 0)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+
+    const auto isSkipped = [&](size_t k) {
+        return itsOffsets[k] >= skipBegin && itsOffsets[k] < skipEnd;
+    };
+    size_t longest = 0;
+    size_t before  = begin;
+    while (before > 0 && isSkipped(before - 1))
+        --before;
+    if (before > 0)
+    {
+        longest = nrOfSameChars(itsText + itsOffsets[before - 1], text);
+        ix      = before - 1;
+    }
+    size_t after = begin;
+    while (after < itsOffsets.size() && isSkipped(after))
+        ++after;
+    if (after < itsOffsets.size())
+    {
+        const size_t same = nrOfSameChars(itsText + itsOffsets[after], text);
+        if (same > longest || before == 0)
+        {
+            longest = same;
+            ix      = after;
+        }
+    }
+    return longest;
+}
+
+size_t BookmarkContainer::nrOfSameInText(size_t a,
+                                         size_t b,
+                                         size_t maxSame) const
+{
+    const char* textA = itsText + itsOffsets[a];
+    const char* textB = itsText + itsOffsets[b];
+    if (itsPrefixes.empty())
+        return nrOfSameChars(textA, textB, maxSame);
+
+    const size_t samePrefix =
+        nrOfSamePrefixChars(itsPrefixes[a], itsPrefixes[b]);
+    const size_t eof = eofPosition(itsPrefixes[a]);
+    if (eof < samePrefix)
+        return std::min(eof, maxSame);
+    if (samePrefix < 8 || maxSame <= 8)
+        return std::min(samePrefix, maxSame);
+
+    return 8 + nrOfSameChars(textA + 8, textB + 8, maxSame - 8);
+}
+
+/**
+ * Returns the first eight characters of the text as a big-endian number,
+ * padded with zeroes if the text is shorter.
+ */
+uint64_t BookmarkContainer::prefixOf(const char* text)
+{
+    uint64_t prefix = 0;
+    int      i      = 0;
+    for (; i < 8 && text[i] != '\0'; ++i)
+        prefix = prefix << 8 | (unsigned char)text[i];
+    return prefix << (8 * (8 - i));
+}
+
+BookmarkContainer BookmarkContainer::sample(size_t stride) const
+{
+    BookmarkContainer result;
+    result.itsText          = itsText;
+    result.itsMarkOffsets   = itsMarkOffsets;
+    result.itsMarkOriginals = itsMarkOriginals;
+    result.itsPartBegins    = itsPartBegins;
+    result.itsParts         = itsParts;
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+    {
+        const size_t offset = itsOffsets[ix];
+        const size_t markIx = itsMarkOffsets.upperBound(offset);
+        const size_t end    = (markIx < itsMarkOffsets.size()) ?
+            itsMarkOffsets[markIx] : SIZE_MAX;
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (size_t i = offset; i < end && itsText[i] != '\0'; ++i)
+            hash = (hash ^ (unsigned char)itsText[i]) * HASH_BASE;
+        if ((hash ^ hash >> 32) % stride == 0)
+            result.itsOffsets.push_back(offset);
+    }
+    return result;
+}
+
+/**
+ * A position counts as duplicated if the length characters from one of the
+ * bookmarks up to length characters before it are found at another bookmark,
+ * since duplications start at bookmarks. The end of the last line of a
+ * duplication is not covered by those, so a position also counts if the
+ * length characters up to it are found elsewhere, and so are those from a
+ * bookmark that ends where they begin or later. Only the hashes of these
+ * windows are counted, while rolling a hash over all of the text. Most
+ * windows are ruled out by a bit that is set for the hashes of the sampled
+ * ones.
+ */
+double BookmarkContainer::estimateDuplication(size_t  length,
+                                              size_t  nrOfSamples,
+                                              double& margin) const
+{
+    margin = 0;
+    const size_t textLength = strlen(itsText);
+    if (length == 0 || length > textLength || nrOfSamples == 0)
+        return 0;
+
+    const unsigned char* text =
+        reinterpret_cast<const unsigned char*>(itsText);
+    uint64_t power = 1; // For the first character in the window.
+    for (size_t i = 1; i < length; ++i)
+        power *= HASH_BASE;
+
+    // Gives the hash of the window from start, or NO_HASH if a file ends
+    // within it.
+    const uint64_t NO_HASH    = 0;
+    auto           windowHash = [&](size_t start) {
+        uint64_t hash = 0;
+        for (size_t i = start; i < start + length; ++i)
+            if (text[i] == SPECIAL_EOF)
+                return NO_HASH;
+            else
+                hash = hash * HASH_BASE + text[i];
+        return hash;
+    };
+
+    // The windows of each position: from the bookmarks up to length
+    // characters before it, up to the position, and from the bookmarks up to
+    // length characters before that.
+    struct Windows
+    {
+        std::vector<uint64_t> starts;
+        uint64_t              end;
+        std::vector<uint64_t> befores;
+    };
+
+    // The generator is seeded alike every time, so the estimate is the same
+    // for the same files.
+    std::mt19937_64                      random(ESTIMATE_SEED);
+    std::vector<Windows>                 samples(nrOfSamples);
+    std::unordered_map<uint64_t, size_t> startCounts; // At bookmarks.
+    std::unordered_map<uint64_t, size_t> endCounts;   // Anywhere.
+    std::vector<bool>                    isSampled(ESTIMATE_FILTER_SIZE);
+    for (size_t s = 0; s < nrOfSamples; ++s)
+    {
+        const size_t position = random() % textLength;
+        const size_t from     = (position + 1 > 2 * length) ?
+            position + 1 - 2 * length : 0;
+        Windows&     windows  = samples[s];
+        windows.end           = (position + 1 >= length) ?
+            windowHash(position + 1 - length) : NO_HASH;
+        for (size_t ix = itsOffsets.lowerBound(from);
+             ix < itsOffsets.size() && itsOffsets[ix] <= position; ++ix)
+        {
+            const size_t offset = itsOffsets[ix];
+            if (offset + length > textLength)
+                break;
+            if (offset + length > position)
+                windows.starts.push_back(windowHash(offset));
+            else if (windows.end != NO_HASH)
+                windows.befores.push_back(windowHash(offset));
+        }
+        endCounts[windows.end] = 0;
+        isSampled[windows.end % ESTIMATE_FILTER_SIZE] = true;
+        for (size_t w = 0; w < windows.starts.size(); ++w)
+        {
+            startCounts[windows.starts[w]] = 0;
+            isSampled[windows.starts[w] % ESTIMATE_FILTER_SIZE] = true;
+        }
+        for (size_t w = 0; w < windows.befores.size(); ++w)
+        {
+            startCounts[windows.befores[w]] = 0;
+            isSampled[windows.befores[w] % ESTIMATE_FILTER_SIZE] = true;
+        }
+    }
+    startCounts.erase(NO_HASH);
+    endCounts.erase(NO_HASH);
+
+    uint64_t  hash    = 0;
+    ptrdiff_t lastEof = -1;
+    size_t    nextIx  = 0; // Of the first bookmark not passed yet.
+    for (size_t i = 0; i < textLength; ++i)
+    {
+        if (i >= length)
+            hash -= text[i - length] * power;
+        hash = hash * HASH_BASE + text[i];
+        if (text[i] == SPECIAL_EOF)
+            lastEof = i;
+        if (i + 1 < length)
+            continue;
+        const size_t start    = i + 1 - length;
+        const bool   isMarked =
+            nextIx < itsOffsets.size() && itsOffsets[nextIx] == start;
+        if (isMarked)
+            ++nextIx;
+        if (not isSampled[hash % ESTIMATE_FILTER_SIZE] ||
+            lastEof >= ptrdiff_t(start))
+        {
+            continue;
+        }
+        const auto endCount = endCounts.find(hash);
+        if (endCount != endCounts.end())
+            ++endCount->second;
+        if (isMarked)
+        {
+            const auto startCount = startCounts.find(hash);
+            if (startCount != startCounts.end())
+                ++startCount->second;
+        }
+    }
+
+    auto isRepeated = [](const std::unordered_map<uint64_t, size_t>& counts,
+                         uint64_t                                    window) {
+        const auto count = counts.find(window);
+        return count != counts.end() && count->second > 1;
+    };
+    auto anyRepeated = [&](const std::vector<uint64_t>& windows) {
+        for (size_t w = 0; w < windows.size(); ++w)
+            if (isRepeated(startCounts, windows[w]))
+                return true;
+        return false;
+    };
+    size_t nrOfDuplicated = 0;
+    for (size_t s = 0; s < nrOfSamples; ++s)
+        if (anyRepeated(samples[s].starts) ||
+            (isRepeated(endCounts, samples[s].end) &&
+             anyRepeated(samples[s].befores)))
+        {
+            ++nrOfDuplicated;
+        }
+
+    const double share = double(nrOfDuplicated) / nrOfSamples;
+    margin = 1.96 * std::sqrt(share * (1 - share) / nrOfSamples);
+    return share;
+}
+
+/**
+ * The prefixes are compared by a rolling hash, which is computed for each
+ * bookmark from the previous one as long as they are close. The hashes are
+ * counted in a filter of two-bit counters, two for each hash, and computed
+ * again when the bookmarks are removed, so only a couple of bytes are needed
+ * per bookmark. A few bookmarks that should have been removed are kept if
+ * hashes collide in the filter. The last bookmark in sorted order is always
+ * kept, since clearWithin() never removes it.
+ */
+void BookmarkContainer::removeUnique(size_t length, size_t minInstances)
+{
+    const size_t size = itsOffsets.size();
+    if (length == 0 || size == 0)
+        return;
+
+    const unsigned char* text =
+        reinterpret_cast<const unsigned char*>(itsText);
+    const size_t textLength = strlen(itsText);
+    uint64_t     power      = 1; // For the first character in the window.
+    for (size_t i = 1; i < length; ++i)
+        power *= HASH_BASE;
+
+    // Rolls the hash to the bookmark at ix, which must come after the one
+    // that it was rolled to before, if any. Tells if its window fits within
+    // its file.
+    size_t    start   = 0; // Of the window that the hash is for.
+    uint64_t  hash    = 0;
+    ptrdiff_t lastEof = -1;
+    bool      isFirst = true;
+    auto      rollTo  = [&](size_t ix) {
+        // The offsets are increasing until the bookmarks are sorted.
+        const size_t offset = itsOffsets[ix];
+        if (offset + length > textLength)
+            return false;
+        if (not isFirst && offset < start + length)
+            for (; start < offset; ++start)
+            {
+                const size_t added = start + length;
+                hash = (hash - text[start] * power) * HASH_BASE + text[added];
+                if (text[added] == SPECIAL_EOF)
+                    lastEof = added;
+            }
+        else
+        {
+            hash = 0;
+            for (size_t i = offset; i < offset + length; ++i)
+            {
+                hash = hash * HASH_BASE + text[i];
+                if (text[i] == SPECIAL_EOF)
+                    lastEof = i;
+            }
+            start = offset;
+        }
+        isFirst = false;
+        return lastEof < ptrdiff_t(offset);
+    };
+
+    // The counters stop at 3, which is enough for the minimum number of
+    // instances that is nearly always wanted, and fewer bookmarks are removed
+    // if more are wanted. When the text is separated, the part that all
+    // bookmarks with a hash are in is kept for it as well, or MIXED if they
+    // are in more than one.
+    static const uint32_t MIXED        = UINT32_MAX;
+    const size_t          wanted       = std::min<size_t>(minInstances, 3);
+    size_t                nrOfCounters = COUNTERS_PER_BOOKMARK;
+    while (nrOfCounters < COUNTERS_PER_BOOKMARK * size)
+        nrOfCounters *= 2;
+    std::vector<uint8_t>  counters(nrOfCounters / 4, 0);
+    std::vector<uint32_t> parts(isSeparated() ?
+                                nrOfCounters / COUNTERS_PER_BOOKMARK : 0, 0);
+    auto counterAt = [&](size_t c) -> size_t {
+        return (counters[c / 4] >> (c % 4 * 2)) & 3;
+    };
+    auto countersOf = [&](uint64_t h, size_t& a, size_t& b) {
+        const uint64_t mixedHash = mixed(h);
+        a = mixedHash & (nrOfCounters - 1);
+        b = mixed(mixedHash) & (nrOfCounters - 1);
+    };
+
+    for (size_t ix = 0; ix < size; ++ix)
+    {
+        if (not rollTo(ix))
+            continue;
+        size_t a, b;
+        countersOf(hash, a, b);
+        if (counterAt(a) < 3)
+            counters[a / 4] += 1 << (a % 4 * 2);
+        if (counterAt(b) < 3)
+            counters[b / 4] += 1 << (b % 4 * 2);
+        if (isSeparated())
+        {
+            uint32_t&      part = parts[a & (parts.size() - 1)];
+            const uint32_t here = uint32_t(partAt(itsOffsets[ix])) + 1;
+            if (part == 0)
+                part = here;
+            else if (part != here)
+                part = MIXED;
+        }
+    }
+
+    // Find the last bookmark among those that come last when only the first
+    // length characters are compared. If there are several and they fit,
+    // they are all kept anyway. Otherwise they have to be compared all the
+    // way, but then a file ends within them, so there are few of them.
+    auto fits = [&](size_t offset) {
+        return offset + length <= textLength &&
+            std::memchr(itsText + offset, SPECIAL_EOF, length) == 0;
+    };
+    const TextOrder     order(itsText, length);
+    std::vector<size_t> lowest(1, 0);
+    for (size_t ix = 1; ix < size; ++ix)
+        if (order(itsOffsets[lowest[0]], itsOffsets[ix]))
+            lowest.assign(1, ix);
+        else if (not order(itsOffsets[ix], itsOffsets[lowest[0]]))
+            lowest.push_back(ix);
+    size_t last = lowest[0];
+    if (lowest.size() > 1 && fits(itsOffsets[last]))
+        last = SIZE_MAX;
+    else
+        for (size_t i = 1; i < lowest.size(); ++i)
+            if (TextOrder(itsText)(itsOffsets[last], itsOffsets[lowest[i]]))
+                last = lowest[i];
+
+    isFirst = true;
+    lastEof = -1;
+    size_t newSize = 0;
+    for (size_t ix = 0; ix < size; ++ix)
+    {
+        const size_t offset = itsOffsets[ix];
+        bool         keep   = (ix == last);
+        if (rollTo(ix))
+        {
+            size_t a, b;
+            countersOf(hash, a, b);
+            keep = keep ||
+                (counterAt(a) >= wanted && counterAt(b) >= wanted &&
+                 (not isSeparated() ||
+                  parts[a & (parts.size() - 1)] == MIXED));
+        }
+        if (keep)
+            itsOffsets.set(newSize++, offset);
+    }
+    itsOffsets.resize(newSize);
+}
+
+/**
+ * The bookmarks whose first length characters are the same are neighbors in
+ * sorted order, so they are found in one pass over the LcpTable, without
+ * any hashes.
+ */
+void BookmarkContainer::removeUniqueSorted(size_t length, size_t minInstances)
+{
+    const size_t size = itsOffsets.size();
+    if (length == 0 || size == 0)
+        return;
+
+    size_t newSize = 0;
+    for (size_t begin = 0; begin < size;)
+    {
+        size_t end   = begin + 1;
+        bool   mixed = false;
+        for (; end < size && nrOfSame(end - 1, end) >= length; ++end)
+            mixed = mixed || isMixed(end - 1, end);
+        const bool keep = end - begin >= minInstances && mixed;
+        for (size_t ix = begin; ix < end; ++ix)
+            if (keep || ix == size - 1)
+            {
+                itsOffsets.set(newSize, itsOffsets[ix]);
+                if (not itsPrefixes.empty())
+                    itsPrefixes[newSize] = itsPrefixes[ix];
+                itsRanks.set(newSize, itsRanks[ix]);
+                ++newSize;
+            }
+        begin = end;
+    }
+    itsOffsets.resize(newSize);
+    if (not itsPrefixes.empty())
+        itsPrefixes.resize(newSize);
+    itsRanks.resize(newSize);
+}
+
+void BookmarkContainer::restoreTextOrder()
+{
+    itsOffsets   = itsMarkOffsets;
+    itsRanks     = OffsetVector();
+    itsLcpTable  = LcpTable();
+    itsSortDepth = SIZE_MAX;
+    std::vector<uint64_t>().swap(itsPrefixes);
+}
+
+void BookmarkContainer::separate(bool crossFile)
+{
+    itsPartBegins.clear();
+    itsParts.clear();
+    const std::vector<size_t> eofs = eofOffsets();
+    for (size_t file = 0; file < eofs.size(); ++file)
+    {
+        // Files in different sets are in different files too.
+        const Bookmark::FileSet set = Bookmark::setOf(file);
+        if (set == Bookmark::NO_SET && not crossFile)
+            return;
+        const size_t part = (set == Bookmark::NO_SET) ? file : size_t(set);
+        if (itsParts.empty() || itsParts.back() != part)
+        {
+            itsPartBegins.push_back((file == 0) ? 0 : eofs[file - 1] + 1);
+            itsParts.push_back(part);
+        }
+    }
+}
+
+size_t BookmarkContainer::partAt(size_t offset) const
+{
+    return itsParts[std::upper_bound(itsPartBegins.begin(),
+                                     itsPartBegins.end(), offset) -
+                    itsPartBegins.begin() - 1];
+}
+
+void BookmarkContainer::removeWithin(
+    const std::vector<std::pair<size_t, size_t> >& ranges)
+{
+    size_t newSize = 0;
+    size_t range   = 0;
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+    {
+        const size_t offset = itsOffsets[ix];
+        while (range < ranges.size() && ranges[range].second <= offset)
+            ++range;
+        if (range < ranges.size() && ranges[range].first <= offset)
+            continue;
+        itsOffsets.set(newSize++, offset);
+    }
+    itsOffsets.resize(newSize);
+}
+
+void BookmarkContainer::sort(const Options& options, size_t depth)
+{
+    itsSortDepth    = depth;
+    itsNrOfRuns     = 0;
+    // The suffix array is only built if it needs no more memory than sorting
+    // with prefixes would, which is seldom the case unless the lines are
+    // very short, since it has two numbers for every character.
+    const size_t textLength = strlen(itsText);
+    const size_t suffixArrayBytes =
+        2 * ((textLength < UINT32_MAX - 1) ? 4 : 8) * (textLength + 1);
+    const size_t sortBytes = size() * SORT_BYTES_PER_BOOKMARK;
+    itsIsRepetitive =
+        not options.lowMemory && suffixArrayBytes <= sortBytes &&
+        (options.memLimit == 0 || suffixArrayBytes <= options.memLimit) &&
+        looksRepetitive();
+    if (itsIsRepetitive)
+    {
+        if (textLength < UINT32_MAX - 1)
+            sortWithSuffixArray<uint32_t>();
+        else
+            sortWithSuffixArray<uint64_t>();
+        itsSortDepth = SIZE_MAX;
+        return;
+    }
+
+    // Sorting in place needs no extra memory at all.
+    if (not options.lowMemory && options.memLimit > 0 &&
+        sortBytes > options.memLimit)
+    {
+        const size_t runSize =
+            std::max<size_t>(options.memLimit / SORT_BYTES_PER_BOOKMARK, 2);
+        if (itsOffsets.isWide())
+            sortInRuns(itsOffsets.wide(), runSize);
+        else
+            sortInRuns(itsOffsets.narrow(), runSize);
+        itsSortDepth = SIZE_MAX;
+        return;
+    }
+
+    const int threads = options.nrOfThreads;
+    // The sorting is done on the underlying vector, so that the comparisons
+    // are compiled for each offset width.
+    if (options.lowMemory)
+    {
+        if (itsOffsets.isWide())
+            sortInPlace(itsOffsets.wide(), threads, depth);
+        else
+            sortInPlace(itsOffsets.narrow(), threads, depth);
+    }
+    else
+    {
+        if (itsOffsets.isWide())
+            sortWithPrefixes(itsOffsets.wide(), threads, depth);
+        else
+            sortWithPrefixes(itsOffsets.narrow(), threads, depth);
+        // Only a full sort gives the number of common characters of
+        // neighbors.
+        if (depth == SIZE_MAX)
+            buildLcpTable();
+    }
+}
+
+/**
+ * Two kept bookmarks keep their order unless their text is the same up to the
+ * end of their files, since it's then decided by the text of the files after
+ * them, which may have changed. Such bookmarks have that many characters in
+ * common with each other, and fewer with any other, so they are neighbors in
+ * the merged order and are sorted again among themselves, by the order of the
+ * text from the beginning of the next file on. That order is found once for
+ * all files, since comparing the text after each bookmark again and again can
+ * take long when many files begin the same way.
+ */
+void BookmarkContainer::sortUpdated(const BookmarkContainer&   old,
+                                    const std::vector<size_t>& newBegins)
+{
+    static const size_t       NONE    = SIZE_MAX;
+    const std::vector<size_t> oldEofs = old.eofOffsets();
+    const std::vector<size_t> eofs    = eofOffsets();
+
+    // The kept bookmarks in sorted order, where they are now, with their
+    // ranks in the old LcpTable.
+    std::vector<size_t> kept;
+    std::vector<size_t> keptRanks;
+    std::vector<bool>   isKept(eofs.size(), false);
+    for (size_t file = 0; file < newBegins.size(); ++file)
+        if (newBegins[file] != NONE)
+            isKept[std::lower_bound(eofs.begin(), eofs.end(),
+                                    newBegins[file]) - eofs.begin()] = true;
+    for (size_t ix = 0; ix < old.size(); ++ix)
+    {
+        const size_t offset = old.offset(ix);
+        const size_t file   = std::lower_bound(oldEofs.begin(), oldEofs.end(),
+                                               offset) - oldEofs.begin();
+        if (newBegins[file] == NONE)
+            continue;
+        const size_t begin = (file == 0) ? 0 : oldEofs[file - 1] + 1;
+        kept.push_back(offset - begin + newBegins[file]);
+        keptRanks.push_back(old.itsRanks[ix]);
+    }
+
+    const TextOrder     order(itsText);
+    std::vector<size_t> added;
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+    {
+        const size_t offset = itsOffsets[ix];
+        if (not isKept[std::lower_bound(eofs.begin(), eofs.end(), offset) -
+                       eofs.begin()])
+        {
+            added.push_back(offset);
+        }
+    }
+    std::stable_sort(added.begin(), added.end(), order);
+
+    std::vector<size_t> merged;
+    std::vector<size_t> ranks; // NONE for the added bookmarks.
+    for (size_t k = 0, a = 0; k < kept.size() || a < added.size();)
+        if (a == added.size() ||
+            (k < kept.size() && order(kept[k], added[a])))
+        {
+            merged.push_back(kept[k]);
+            ranks.push_back(keptRanks[k++]);
+        }
+        else
+        {
+            merged.push_back(added[a++]);
+            ranks.push_back(NONE);
+        }
+
+    std::vector<size_t> sames;
+    for (size_t ix = 0; ix + 1 < merged.size(); ++ix)
+        if (ranks[ix] != NONE && ranks[ix + 1] != NONE)
+            sames.push_back(old.itsLcpTable.minimum(
+                std::min(ranks[ix], ranks[ix + 1]),
+                std::max(ranks[ix], ranks[ix + 1])));
+        else
+            sames.push_back(nrOfSameChars(itsText + merged[ix],
+                                          itsText + merged[ix + 1]));
+
+    // The rank of the text after the end of each file, where the last one is
+    // followed by nothing.
+    std::vector<size_t> nextFiles(eofs.size());
+    for (size_t file = 0; file < eofs.size(); ++file)
+        nextFiles[file] = eofs[file] + 1;
+    std::sort(nextFiles.begin(), nextFiles.end(), order);
+    std::vector<size_t> nextRanks(eofs.size());
+    for (size_t r = 0; r < nextFiles.size(); ++r)
+        nextRanks[std::lower_bound(eofs.begin(), eofs.end(),
+                                   nextFiles[r] - 1) - eofs.begin()] = r;
+    const auto nextRank = [&](size_t offset) {
+        return nextRanks[std::lower_bound(eofs.begin(), eofs.end(), offset) -
+                         eofs.begin()];
+    };
+
+    for (size_t begin = 0; begin < merged.size();)
+    {
+        size_t end = begin + 1;
+        while (end < merged.size() &&
+               sames[end - 1] == toEof(eofs, merged[end - 1]) &&
+               sames[end - 1] == toEof(eofs, merged[end]))
+        {
+            ++end;
+        }
+        if (end - begin > 1)
+            std::sort(merged.begin() + begin, merged.begin() + end,
+                      [&](size_t a, size_t b) {
+                          return nextRank(a) < nextRank(b);
+                      });
+        begin = end;
+    }
+
+    itsOffsets  = OffsetVector();
+    itsRanks    = OffsetVector();
+    itsLcpTable = LcpTable();
+    for (size_t ix = 0; ix < merged.size(); ++ix)
+    {
+        itsOffsets.push_back(merged[ix]);
+        itsRanks.push_back(ix);
+        if (ix < sames.size())
+            itsLcpTable.add(sames[ix]);
+    }
+    itsLcpTable.build();
+    itsSortDepth    = SIZE_MAX;
+    itsIsRepetitive = false;
+    std::vector<uint64_t>().swap(itsPrefixes);
+}
+
+void BookmarkContainer::sortSubset(const std::vector<size_t>& ixs,
+                                   size_t                     depth)
+{
+    std::vector<size_t> offsets(ixs.size());
+    for (size_t i = 0; i < ixs.size(); ++i)
+        offsets[i] = itsOffsets[ixs[i]];
+    // The characters before the depth are known to be the same.
+    std::sort(offsets.begin(), offsets.end(), TextOrder(itsText + depth));
+    for (size_t i = 0; i < ixs.size(); ++i)
+    {
+        itsOffsets.set(ixs[i], offsets[i]);
+        if (not itsPrefixes.empty())
+            itsPrefixes[ixs[i]] = prefixOf(itsText + offsets[i]);
+    }
+}
+
+/**
+ * Sorts a sample of the bookmarks, comparing no more than SAMPLE_DEPTH
+ * characters, and counts the neighbors in the sample that have that many
+ * characters in common.
+ */
+bool BookmarkContainer::looksRepetitive() const
+{
+    const size_t size       = itsOffsets.size();
+    const size_t sampleSize = std::min(size, SAMPLE_SIZE);
+    if (sampleSize < 2)
+        return false;
+
+    // One bookmark from each stretch, at a position that varies.
+    std::vector<size_t> sample(sampleSize);
+    for (size_t i = 0; i < sampleSize; ++i)
+    {
+        const size_t begin = i * size / sampleSize;
+        const size_t end   = (i + 1) * size / sampleSize;
+        sample[i] = itsOffsets[begin + (i * 2654435761u) % (end - begin)];
+    }
+    std::sort(sample.begin(), sample.end(), TextOrder(itsText, SAMPLE_DEPTH));
+
+    size_t nrOfLong = 0;
+    for (size_t i = 0; i + 1 < sampleSize; ++i)
+        if (strncmp(itsText + sample[i], itsText + sample[i + 1],
+                    SAMPLE_DEPTH) == 0)
+        {
+            ++nrOfLong;
+        }
+    return double(nrOfLong) / (sampleSize - 1) >= REPETITIVE_SHARE;
+}
+
+/**
+ * Replaces the bookmarks with the same ones in sorted order, which is the
+ * reverse of their order in the suffix array, and builds the LcpTable from
+ * the common characters of the suffixes in between.
+ */
+template <typename Index>
+void BookmarkContainer::sortWithSuffixArray()
+{
+    const size_t       n = strlen(itsText) + 1;
+    std::vector<Index> sa;
+    std::vector<Index> plcp;
+    buildSuffixArray(itsText, n, sa);
+    buildPermutedLcp(itsText, sa, plcp);
+
+    std::vector<bool> isBookmark(n, false);
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+        isBookmark[itsOffsets[ix]] = true;
+    const std::vector<size_t> eofs = eofOffsets();
+
+    itsRanks    = OffsetVector();
+    itsLcpTable = LcpTable();
+    size_t sortedIx = 0;
+    size_t same     = SIZE_MAX; // Fewest common characters since the last.
+    for (size_t k = n; k-- > 0;)
+    {
+        const size_t offset = sa[k];
+        if (isBookmark[offset])
+        {
+            // The common characters end at the end of the file.
+            if (sortedIx > 0)
+                itsLcpTable.add(std::min(same, toEof(eofs, offset)));
+            itsOffsets.set(sortedIx, offset);
+            itsRanks.push_back(sortedIx);
+            ++sortedIx;
+            same = SIZE_MAX;
+        }
+        same = std::min(same, size_t(plcp[offset]));
+    }
+    itsLcpTable.build();
+
+    itsPrefixes.resize(itsOffsets.size());
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+        itsPrefixes[ix] = prefixOf(itsText + itsOffsets[ix]);
+}
+
+std::vector<size_t> BookmarkContainer::eofOffsets() const
+{
+    std::vector<size_t> eofs;
+    for (const char* eof = strchr(itsText, SPECIAL_EOF); eof != 0;
+         eof = strchr(eof + 1, SPECIAL_EOF))
+    {
+        eofs.push_back(eof - itsText);
+    }
+    return eofs;
+}
+
+/**
+ * Sorts runs of the bookmarks in memory and writes them to temporary files,
+ * which are then merged with a heap of the first bookmark left in each. As
+ * soon as there are MAX_MERGED_RUNS runs of the same length, they are merged
+ * into a longer one, so that only a few files are open at a time. Nothing is
+ * kept for each bookmark but its offset, so the bookmarks are searched like
+ * with lowMemory afterwards.
+ */
+template <typename Offset>
+void BookmarkContainer::sortInRuns(std::vector<Offset>& offsets,
+                                   size_t               runSize)
+{
+    typedef SortKey<Offset>            Key;
+    typedef std::unique_ptr<SortedRun> Run;
+    typedef std::pair<Key, size_t>     Head; // With the run it's in.
+
+    const KeyOrder order(itsText, SIZE_MAX);
+    auto           later = [&](const Head& a, const Head& b) {
+        return order(b.first, a.first);
+    };
+
+    // Calls add() with the bookmarks of the runs in sorted order.
+    auto merge = [&](const std::vector<Run>&           runs,
+                     const std::function<void(size_t)>& add) {
+        std::priority_queue<Head, std::vector<Head>, decltype(later)> heads(
+            later);
+        auto push = [&](size_t r) {
+            size_t offset;
+            if (runs[r]->next(offset))
+                heads.push(Head(Key{ prefixOf(itsText + offset),
+                                     Offset(offset) },
+                                r));
+        };
+        for (size_t r = 0; r < runs.size(); ++r)
+            push(r);
+        while (not heads.empty())
+        {
+            const Head head = heads.top();
+            heads.pop();
+            add(head.first.offset);
+            push(head.second);
+        }
+    };
+
+    // The runs of each length, the first ones from one sort in memory, the
+    // next ones from merging MAX_MERGED_RUNS of those, and so on.
+    std::vector<std::vector<Run> > levels;
+    itsNrOfRuns = 0;
+    for (size_t begin = 0; begin < offsets.size(); begin += runSize)
+    {
+        const size_t     end = std::min(begin + runSize, offsets.size());
+        std::vector<Key> keys(end - begin);
+        for (size_t ix = begin; ix < end; ++ix)
+        {
+            keys[ix - begin].prefix = prefixOf(itsText + offsets[ix]);
+            keys[ix - begin].offset = offsets[ix];
+        }
+        std::stable_sort(keys.begin(), keys.end(), order);
+
+        Run run(new SortedRun);
+        for (size_t i = 0; i < keys.size(); ++i)
+            run->add(keys[i].offset);
+        ++itsNrOfRuns;
+        for (size_t level = 0; run; ++level)
+        {
+            if (level == levels.size())
+                levels.push_back(std::vector<Run>());
+            levels[level].push_back(std::move(run));
+            if (levels[level].size() < MAX_MERGED_RUNS)
+                break;
+            run.reset(new SortedRun);
+            SortedRun& merged = *run;
+            merge(levels[level], [&](size_t offset) { merged.add(offset); });
+            levels[level].clear();
+        }
+    }
+
+    std::vector<Run> runs;
+    for (size_t level = 0; level < levels.size(); ++level)
+        for (size_t r = 0; r < levels[level].size(); ++r)
+            runs.push_back(std::move(levels[level][r]));
+    size_t ix = 0;
+    merge(runs, [&](size_t offset) { offsets[ix++] = Offset(offset); });
+
+    std::vector<uint64_t>().swap(itsPrefixes);
+    itsRanks    = OffsetVector();
+    itsLcpTable = LcpTable();
+}
+
+void BookmarkContainer::buildLcpTable()
+{
+    itsRanks    = OffsetVector();
+    itsLcpTable = LcpTable();
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+    {
+        itsRanks.push_back(ix);
+        if (ix + 1 < itsOffsets.size())
+            itsLcpTable.add(nrOfSameInText(ix, ix + 1, SIZE_MAX));
+    }
+    itsLcpTable.build();
+}
+
+/**
+ * Sorts the bookmarks together with their prefixes, which are kept for later
+ * comparisons. When several threads are used, the bookmarks are first
+ * distributed into buckets on their first two characters with a stable
+ * counting sort. The buckets come in the same order as the sorted strings,
+ * so the result is identical to sorting the whole array at once.
+ */
+template <typename Offset>
+void BookmarkContainer::sortWithPrefixes(std::vector<Offset>& offsets,
+                                         int                  nrOfThreads,
+                                         size_t               depth)
+{
+    typedef SortKey<Offset> Key;
+
+    std::vector<Key> keys(offsets.size());
+    for (size_t ix = 0; ix < offsets.size(); ++ix)
+    {
+        keys[ix].prefix = prefixOf(itsText + offsets[ix]);
+        keys[ix].offset = offsets[ix];
+    }
+
+    const KeyOrder order(itsText, depth);
+    if (nrOfThreads > 1 && keys.size() >= MIN_PARALLEL_SIZE)
+    {
+        auto bucket = [](const Key& k) {
+            return NR_OF_BUCKETS - 1 - (k.prefix >> 48);
+        };
+        const std::vector<size_t> starts = bucketStarts(keys, bucket);
+        std::vector<Key>          sorted(keys.size());
+        std::vector<size_t>       nextPos(starts.begin(), starts.end() - 1);
+        for (size_t ix = 0; ix < keys.size(); ++ix)
+            sorted[nextPos[bucket(keys[ix])]++] = keys[ix];
+        keys.swap(sorted);
+
+        sortBuckets(keys, starts, nrOfThreads,
+                    [&](typename std::vector<Key>::iterator begin,
+                        typename std::vector<Key>::iterator end) {
+                        std::stable_sort(begin, end, order);
+                    });
+    }
+    else
+        // std::stable_sort(), which is a merge sort, has proved to be much
+        // faster than std::sort() in this context.
+        std::stable_sort(keys.begin(), keys.end(), order);
+
+    itsPrefixes.resize(keys.size());
+    for (size_t ix = 0; ix < keys.size(); ++ix)
+    {
+        itsPrefixes[ix] = keys[ix].prefix;
+        offsets[ix]     = keys[ix].offset;
+    }
+}
+
+/**
+ * Sorts the bookmark offsets without any extra memory apart from the bucket
+ * counters. Since no two bookmarks have the same text, std::sort() gives the
+ * same result as std::stable_sort() would, although somewhat slower. With
+ * several threads, the offsets are first permuted into buckets in place.
+ */
+template <typename Offset>
+void BookmarkContainer::sortInPlace(std::vector<Offset>& offsets,
+                                    int                  nrOfThreads,
+                                    size_t               depth)
+{
+    std::vector<uint64_t>().swap(itsPrefixes);
+
+    const TextOrder order(itsText, depth);
+    if (nrOfThreads < 2 || offsets.size() < MIN_PARALLEL_SIZE)
+    {
+        std::sort(offsets.begin(), offsets.end(), order);
+        return;
+    }
+
+    const char* text   = itsText;
+    auto        bucket = [text](Offset offset) {
+        return bucketOf(text + offset);
+    };
+    const std::vector<size_t> starts = bucketStarts(offsets, bucket);
+    std::vector<size_t>       nextPos(starts.begin(), starts.end() - 1);
+    for (size_t b = 0; b < NR_OF_BUCKETS; ++b)
+        while (nextPos[b] < starts[b + 1])
+        {
+            // Move offsets around in a cycle until one that belongs in
+            // bucket b comes back.
+            Offset offset = offsets[nextPos[b]];
+            for (size_t ob = bucket(offset); ob != b; ob = bucket(offset))
+                std::swap(offset, offsets[nextPos[ob]++]);
+            offsets[nextPos[b]++] = offset;
+        }
+
+    sortBuckets(offsets, starts, nrOfThreads,
+                [&](typename std::vector<Offset>::iterator begin,
+                    typename std::vector<Offset>::iterator end) {
+                    std::sort(begin, end, order);
+                });
 }
 
 void BookmarkContainer::clearWithin(const Duplication& d)
 {
+    std::vector<bool> cleared(itsOffsets.size(), false);
     for (int i = 0; i < d.instances; ++i)
     {
-        const char* reportStart =
-          itsBookmarks[d.indexOf1stInstance + i].itsProcessedText;
+        const size_t instanceIx = d.indexOf1stInstance + i;
+        // An instance that has been cleared already doesn't clear anything.
+        if (cleared[instanceIx])
+            continue;
+        const size_t reportStart = itsOffsets[instanceIx];
 
-        for (size_t ix = 0; ix < itsBookmarks.size() - 1; ++ix)
+        for (size_t ix = 0; ix < itsOffsets.size() - 1; ++ix)
         {
-            const char* t = itsBookmarks[ix].itsProcessedText;
-            if (t >= reportStart && t < reportStart + d.longestSame)
-                itsBookmarks[ix].clear();
+            const size_t o = itsOffsets[ix];
+            if (o >= reportStart && o < reportStart + d.longestSame)
+                cleared[ix] = true;
         }
     }
     // Remove all cleared bookmarks while maintaining a sorted array.
-    std::vector<Bookmark>::iterator newEnd =
-        std::remove_if(itsBookmarks.begin(), itsBookmarks.end(),
-                       [](const Bookmark& b) { return b.isCleared(); });
-
-    itsBookmarks.resize(newEnd - itsBookmarks.begin());
+    size_t newSize = 0;
+    for (size_t ix = 0; ix < itsOffsets.size(); ++ix)
+        if (not cleared[ix])
+        {
+            itsOffsets.set(newSize, itsOffsets[ix]);
+            if (not itsPrefixes.empty())
+                itsPrefixes[newSize] = itsPrefixes[ix];
+            if (hasLcpTable())
+                itsRanks.set(newSize, itsRanks[ix]);
+            ++newSize;
+        }
+    itsOffsets.resize(newSize);
+    if (not itsPrefixes.empty())
+        itsPrefixes.resize(newSize);
+    if (hasLcpTable())
+        itsRanks.resize(newSize);
 }
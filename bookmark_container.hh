@@ -1,36 +1,262 @@
 #ifndef BOOKMARK_CONTAINER_HH
 #define BOOKMARK_CONTAINER_HH
 
+#include <cstdint>
+#include <utility> // pair
 #include <vector>
 
-class Bookmark;
+#include "bookmark.hh"
+#include "lcp_table.hh"
+#include "offset_vector.hh"
+
 class Options;
 struct Duplication;
 
+/**
+ * Keeps the bookmarks as a structure of arrays. A bookmark is an offset into
+ * the processed text, stored with 32 bits unless the text is bigger than
+ * 4 GB. The original indexes are kept in a separate array in the order the
+ * bookmarks were added, which is also the order of their offsets, so the
+ * original index of a sorted bookmark is found with a binary search.
+ *
+ * Unless memory is to be saved, the first eight characters of the text are
+ * also stored for each bookmark as a big-endian number. Most comparisons can
+ * then be decided without reading the processed text, which is scattered all
+ * over memory.
+ */
 class BookmarkContainer
 {
 public:
-    void   addBookmark(const Bookmark& bm) { itsBookmarks.push_back(bm); }
-    size_t size() const                    { return itsBookmarks.size(); }
+    BookmarkContainer():
+        itsText(0),
+        itsSortDepth(SIZE_MAX),
+        itsIsRepetitive(false),
+        itsNrOfRuns(0) {}
+
+    void   setText(const char* processedText) { itsText = processedText; }
+    void   addBookmark(const Bookmark& bm);
+    size_t size() const { return itsOffsets.size(); }
+
+    Bookmark operator[](size_t ix) const;
+
+    const char* text() const { return itsText; }
+
+    // Where in the processed text the bookmark at the given index points.
+    size_t offset(size_t ix) const { return itsOffsets[ix]; }
+
+    // The bookmarks in the order they were added, which is text order, with
+    // where they point in the processed and the original text.
+    size_t nrOfMarks() const { return itsMarkOffsets.size(); }
+    size_t markOffset(size_t markIx) const { return itsMarkOffsets[markIx]; }
+    size_t markOriginal(size_t markIx) const
+    {
+        return itsMarkOriginals[markIx];
+    }
+
+    /**
+     * Splits the processed text into parts if only duplications across them
+     * are wanted: the two sets of files if there are any, or else each file
+     * on its own if crossFile is set.
+     */
+    void separate(bool crossFile);
+
+    bool isSeparated() const { return not itsParts.empty(); }
+
+    // Which part of the text the offset is in.
+    size_t partAt(size_t offset) const;
+
+    // Is the text at the two offsets in different parts, or are there none?
+    bool isMixedAt(size_t a, size_t b) const
+    {
+        return itsParts.empty() || partAt(a) != partAt(b);
+    }
 
-    void report(int                bookmarkIx,
+    // Are the bookmarks at the two indexes in different parts?
+    bool isMixed(size_t a, size_t b) const
+    {
+        return isMixedAt(itsOffsets[a], itsOffsets[b]);
+    }
+
+    void report(size_t             bookmarkIx,
                 const Duplication& duplication,
                 int                instanceNr,
                 const Options&     options) const;
 
     bool same(size_t      a,
               size_t      b,
-              int         longestSame,
+              size_t      longestSame,
               const char* processedEnd) const;
 
-    int nrOfSame(int a, int b) const;
+    size_t nrOfSame(size_t a, size_t b, size_t maxSame = SIZE_MAX) const;
+
+    // Are the first depth characters of the two bookmarks the same?
+    bool samePrefix(size_t a, size_t b, size_t depth) const;
+
+    /**
+     * Removes the bookmarks whose first length characters are found at no
+     * other bookmark, or that are within length characters of the end of
+     * their file. They have fewer than length characters in common with any
+     * other bookmark. Those whose first length characters are found at fewer
+     * than minInstances bookmarks in all, or only within one part of the text,
+     * are removed too. Must be called before sort().
+     */
+    void removeUnique(size_t length, size_t minInstances = 2);
+
+    /**
+     * Sorts the bookmarks, which must be in text order, after some files have
+     * changed. The other container has the bookmarks from before, sorted with
+     * an LcpTable. Each of its files is either gone or unchanged in this
+     * container, where it begins at the given offset, SIZE_MAX if it's gone.
+     * Only the bookmarks of the files that are not kept are sorted, and they
+     * are merged with the kept ones, whose order and common characters are
+     * known.
+     */
+    void sortUpdated(const BookmarkContainer&   old,
+                     const std::vector<size_t>& newBegins);
+
+    /**
+     * Removes the same bookmarks as removeUnique() after a full sort with an
+     * LcpTable, such as one read from an index, instead of before it.
+     */
+    void removeUniqueSorted(size_t length, size_t minInstances = 2);
+
+    /**
+     * Puts the bookmarks back in text order, so that they can be searched in
+     * ways that must begin before the sort.
+     */
+    void restoreTextOrder();
+
+    /**
+     * Removes the bookmarks within the given ranges of the processed text,
+     * which must be in text order. Must be called before sort().
+     */
+    void removeWithin(const std::vector<std::pair<size_t, size_t> >& ranges);
+
+    /**
+     * Returns a container with about one in stride of the bookmarks. They
+     * are chosen by their text up to the next bookmark, so most bookmarks
+     * within two instances of a duplication are chosen alike. Must be called
+     * before sort().
+     */
+    BookmarkContainer sample(size_t stride) const;
+
+    /**
+     * Estimates the share of the processed text that is within duplications
+     * of at least length characters from a number of random positions, and
+     * sets the margin of error with 95 % confidence. Must be called before
+     * sort().
+     */
+    double estimateDuplication(size_t  length,
+                               size_t  nrOfSamples,
+                               double& margin) const;
 
-    void sort();
+    /**
+     * Sorts the bookmarks by their first depth characters, or by their whole
+     * text if no depth is given. Unless memory is to be saved, or the sort
+     * has to be done in runs on disk to stay within the memory limit, an
+     * LcpTable is also built after a full sort, after which comparisons need
+     * not look at the text.
+     */
+    void sort(const Options& options, size_t depth = SIZE_MAX);
+
+    // How many characters the bookmarks have been sorted by, SIZE_MAX for
+    // all of them.
+    size_t sortDepth() const { return itsSortDepth; }
+
+    /**
+     * Did the last sort find the text so repetitive that it was sorted by
+     * building a suffix array instead? That takes linear time, while sorting
+     * by comparisons would go through the same long prefixes again and
+     * again.
+     */
+    bool isRepetitive() const { return itsIsRepetitive; }
+
+    // Into how many runs on disk the last sort had to split the bookmarks to
+    // stay within the memory limit, 0 if it was done in memory.
+    size_t nrOfRuns() const { return itsNrOfRuns; }
+
+    // The offsets of the ends of the files in the processed text.
+    std::vector<size_t> eofOffsets() const;
+
+    /**
+     * Sorts the bookmarks at the given increasing indexes among themselves by
+     * their whole text. They must have their first depth characters in
+     * common. Bookmarks at other indexes stay where they are.
+     */
+    void sortSubset(const std::vector<size_t>& ixs, size_t depth);
+
+    bool hasLcpTable() const { return not itsLcpTable.empty(); }
+
+    /**
+     * Returns the first and the last of the bookmarks around the one at ix
+     * that have at least the given number of characters in common with it.
+     * Needs the LcpTable.
+     */
+    void sameRange(size_t ix, size_t same, size_t& first, size_t& last) const;
+
+    /**
+     * Finds the bookmark with the most characters in common with a text from
+     * elsewhere, which ends with a SPECIAL_EOF, by a binary search. The
+     * bookmarks from skipBegin up to skipEnd in the processed text are left
+     * out. Returns the number of common characters, 0 if there is no such
+     * bookmark, and sets ix to it. Needs a full sort.
+     */
+    size_t findLongest(const char* text,
+                       size_t      skipBegin,
+                       size_t      skipEnd,
+                       size_t&     ix) const;
 
     void clearWithin(const Duplication& duplication);
 
 private:
-    std::vector<Bookmark> itsBookmarks;
+    friend class IndexFile;
+
+    template <typename Offset>
+    struct SortKey
+    {
+        uint64_t prefix;
+        Offset   offset;
+    };
+
+    class KeyOrder;
+    class TextOrder;
+
+    static uint64_t prefixOf(const char* text);
+
+    size_t nrOfSameInText(size_t a, size_t b, size_t maxSame) const;
+    void   buildLcpTable();
+    bool   looksRepetitive() const;
+
+    template <typename Index>
+    void sortWithSuffixArray();
+
+    template <typename Offset>
+    void sortInRuns(std::vector<Offset>& offsets, size_t runSize);
+
+    template <typename Offset>
+    void sortWithPrefixes(std::vector<Offset>& offsets,
+                          int                  nrOfThreads,
+                          size_t               depth);
+
+    template <typename Offset>
+    void sortInPlace(std::vector<Offset>& offsets,
+                     int                  nrOfThreads,
+                     size_t               depth);
+
+    const char*           itsText;
+    OffsetVector          itsMarkOffsets;   // In the order they were added.
+    OffsetVector          itsMarkOriginals; // Original index of each mark.
+    OffsetVector          itsOffsets;       // Sorted.
+    std::vector<uint64_t> itsPrefixes;      // Empty if saving memory.
+    OffsetVector          itsRanks;         // Sorted index before clearing.
+    LcpTable              itsLcpTable;      // Empty if saving memory.
+    size_t                itsSortDepth;
+    bool                  itsIsRepetitive;
+    size_t                itsNrOfRuns;
+
+    // Where each part of the text begins, if it is separated.
+    std::vector<size_t> itsPartBegins;
+    std::vector<size_t> itsParts;
 };
 
 #endif
@@ -0,0 +1,223 @@
+#include "compare.hh"
+#include "file.hh" // SPECIAL_EOF
+
+#include <algorithm> // min
+#include <cstddef>   // ptrdiff_t
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+typedef size_t (*NrOfSameFunction)(const char*, const char*, size_t);
+typedef bool   (*SameFunction)(const char*, const char*, size_t);
+
+static size_t scalarNrOfSame(const char* a, const char* b, size_t maxSame)
+{
+    size_t index = 0;
+    for (; index < maxSame && a[index] == b[index]; ++index)
+        // The characters are equal so we only have to check one of them.
+        if (a[index] == SPECIAL_EOF)
+            break;
+    return index;
+}
+
+static bool scalarSame(const char* a, const char* b, size_t lastIx)
+{
+    for (ptrdiff_t i = lastIx; i >= 0; --i)
+        if (a[i] != b[i])
+            return false;
+    return true;
+}
+
+#ifdef HAVE_X86_KERNELS
+
+// The vectorized versions compare a whole register of characters at a time,
+// and find the first difference or SPECIAL_EOF from the bit mask that says
+// which of the characters compared equal.
+
+__attribute__((target("sse2")))
+static size_t sse2NrOfSame(const char* a, const char* b, size_t maxSame)
+{
+    const __m128i eof = _mm_set1_epi8(SPECIAL_EOF);
+    for (size_t i = 0; i < maxSame; i += 16)
+    {
+        const __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        const __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        const unsigned stop =
+            (~_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) & 0xffff) |
+            _mm_movemask_epi8(_mm_cmpeq_epi8(va, eof));
+        if (stop != 0)
+            return std::min(maxSame, i + __builtin_ctz(stop));
+    }
+    return maxSame;
+}
+
+__attribute__((target("sse2")))
+static unsigned sse2EqualMask(const char* a, const char* b)
+{
+    return _mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)a),
+                       _mm_loadu_si128((const __m128i*)b)));
+}
+
+__attribute__((target("sse2")))
+static bool sse2Same(const char* a, const char* b, size_t lastIx)
+{
+    const size_t length = lastIx + 1;
+    if (length < 16)
+    {
+        const unsigned wanted = (1u << length) - 1;
+        return (sse2EqualMask(a, b) & wanted) == wanted;
+    }
+    // Work backwards from the far end. The last step overlaps the one before
+    // unless the length is a multiple of 16.
+    for (ptrdiff_t i = length - 16; i > 0; i -= 16)
+        if (sse2EqualMask(a + i, b + i) != 0xffff)
+            return false;
+    return sse2EqualMask(a, b) == 0xffff;
+}
+
+__attribute__((target("avx2")))
+static size_t avx2NrOfSame(const char* a, const char* b, size_t maxSame)
+{
+    const __m256i eof = _mm256_set1_epi8(SPECIAL_EOF);
+    for (size_t i = 0; i < maxSame; i += 32)
+    {
+        const __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        const unsigned stop =
+            ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)) |
+            (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, eof));
+        if (stop != 0)
+            return std::min(maxSame, i + __builtin_ctz(stop));
+    }
+    return maxSame;
+}
+
+__attribute__((target("avx2")))
+static unsigned avx2EqualMask(const char* a, const char* b)
+{
+    return _mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)a),
+                          _mm256_loadu_si256((const __m256i*)b)));
+}
+
+__attribute__((target("avx2")))
+static bool avx2Same(const char* a, const char* b, size_t lastIx)
+{
+    const size_t length = lastIx + 1;
+    if (length < 32)
+    {
+        const unsigned wanted = (1u << length) - 1;
+        return (avx2EqualMask(a, b) & wanted) == wanted;
+    }
+    for (ptrdiff_t i = length - 32; i > 0; i -= 32)
+        if (avx2EqualMask(a + i, b + i) != 0xffffffff)
+            return false;
+    return avx2EqualMask(a, b) == 0xffffffff;
+}
+
+__attribute__((target("avx512bw")))
+static size_t avx512NrOfSame(const char* a, const char* b, size_t maxSame)
+{
+    const __m512i eof = _mm512_set1_epi8(SPECIAL_EOF);
+    for (size_t i = 0; i < maxSame; i += 64)
+    {
+        const __m512i va = _mm512_loadu_si512(a + i);
+        const __m512i vb = _mm512_loadu_si512(b + i);
+        const __mmask64 stop = _mm512_cmpneq_epi8_mask(va, vb) |
+                               _mm512_cmpeq_epi8_mask(va, eof);
+        if (stop != 0)
+            return std::min(maxSame, size_t(i + __builtin_ctzll(stop)));
+    }
+    return maxSame;
+}
+
+__attribute__((target("avx512bw")))
+static __mmask64 avx512EqualMask(const char* a, const char* b)
+{
+    return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(a),
+                                  _mm512_loadu_si512(b));
+}
+
+__attribute__((target("avx512bw")))
+static bool avx512Same(const char* a, const char* b, size_t lastIx)
+{
+    const size_t length = lastIx + 1;
+    if (length < 64)
+    {
+        const __mmask64 wanted = (1ULL << length) - 1;
+        return (avx512EqualMask(a, b) & wanted) == wanted;
+    }
+    for (ptrdiff_t i = length - 64; i > 0; i -= 64)
+        if (avx512EqualMask(a + i, b + i) != ~0ULL)
+            return false;
+    return avx512EqualMask(a, b) == ~0ULL;
+}
+
+#endif // HAVE_X86_KERNELS
+
+static CompareKernel    theirKernel   = SCALAR;
+static NrOfSameFunction theirNrOfSame = scalarNrOfSame;
+static SameFunction     theirSame     = scalarSame;
+
+// Selects the fastest kernel before main() is entered.
+static const bool theirInitialization = selectCompareKernel(AVX512) ||
+                                        selectCompareKernel(AVX2)   ||
+                                        selectCompareKernel(SSE2);
+
+size_t nrOfSameChars(const char* a, const char* b, size_t maxSame)
+{
+    return theirNrOfSame(a, b, maxSame);
+}
+
+bool sameChars(const char* a, const char* b, size_t lastIx)
+{
+    return theirSame(a, b, lastIx);
+}
+
+bool selectCompareKernel(CompareKernel kernel)
+{
+#ifdef HAVE_X86_KERNELS
+    // Needed since we may be called before the constructors in libgcc.
+    __builtin_cpu_init();
+#endif
+    switch (kernel)
+    {
+    case SCALAR:
+        theirNrOfSame = scalarNrOfSame;
+        theirSame     = scalarSame;
+        break;
+#ifdef HAVE_X86_KERNELS
+    case SSE2:
+        if (not __builtin_cpu_supports("sse2"))
+            return false;
+        theirNrOfSame = sse2NrOfSame;
+        theirSame     = sse2Same;
+        break;
+    case AVX2:
+        if (not __builtin_cpu_supports("avx2"))
+            return false;
+        theirNrOfSame = avx2NrOfSame;
+        theirSame     = avx2Same;
+        break;
+    case AVX512:
+        if (not __builtin_cpu_supports("avx512bw"))
+            return false;
+        theirNrOfSame = avx512NrOfSame;
+        theirSame     = avx512Same;
+        break;
+#endif
+    default:
+        return false;
+    }
+    theirKernel = kernel;
+    return true;
+}
+
+const char* compareKernelName()
+{
+    static const char* names[] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+    return names[theirKernel];
+}
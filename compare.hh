@@ -0,0 +1,39 @@
+#ifndef COMPARE_HH
+#define COMPARE_HH
+
+#include <cstdint> // SIZE_MAX
+#include <cstdlib> // size_t
+
+/**
+ * The vectorized comparisons may read this many characters past the end of
+ * the processed text, so the buffer must be that much larger.
+ */
+const size_t COMPARE_PADDING = 64;
+
+enum CompareKernel { SCALAR, SSE2, AVX2, AVX512 };
+
+/**
+ * How many characters are equal in the two texts? Counting stops at the first
+ * difference or at the first SPECIAL_EOF, whichever comes first, but never
+ * goes beyond maxSame.
+ */
+extern size_t nrOfSameChars(const char* a,
+                            const char* b,
+                            size_t      maxSame = SIZE_MAX);
+
+/**
+ * Are the characters with index 0 to lastIx equal in the two texts? The
+ * comparison starts at the far end, where a difference is most likely.
+ */
+extern bool sameChars(const char* a, const char* b, size_t lastIx);
+
+/**
+ * Makes the comparison functions use the given kernel. The fastest one that
+ * the CPU supports is selected at start-up. Returns false, and changes
+ * nothing, if the CPU doesn't support the kernel.
+ */
+extern bool selectCompareKernel(CompareKernel kernel);
+
+extern const char* compareKernelName();
+
+#endif
@@ -8,42 +8,680 @@
 //
 //=============================================================================
 
+#include <cstddef>    // ptrdiff_t
 #include <cstdlib>    // EXIT_SUCCESS, EXIT_FAILURE, abs
 #include <iostream>   // cout, endl
 #include <cstring>    // strlen
+#include <ctime>      // time
 #include <algorithm>  // min
+#include <climits>    // INT_MAX
+#include <cstdint>    // SIZE_MAX
+#include <iomanip>    // setprecision
+#include <atomic>
+#include <thread>
+#include <utility>    // move, pair
+#include <map>
+#include <string>
+#include <sys/stat.h> // stat
+#include <vector>
 
 #include "dupfind.hh"
 #include "duplication.hh"
+#include "duplication_profile.hh"
+#include "file.hh" // readFileIntoString
 #include "bookmark.hh"
 #include "bookmark_container.hh"
+#include "compare.hh" // nrOfSameChars
+#include "gap_chainer.hh"
+#include "index_file.hh"
+#include "min_hasher.hh"
 #include "options.hh"
+#include "parse_cache.hh"
 #include "parser.hh"
+#include "repeat_enumerator.hh"
+#include "tree_hasher.hh"
+#include "winnower.hh"
 
 using std::cout;
 
+// Below this number of bookmarks per thread it's not worth starting threads.
+static const size_t MIN_PAIRS_PER_THREAD = 1000;
+
+// The margin of error of an estimate is below one percentage point with this
+// many samples, since 1.96 * sqrt(0.5 * 0.5 / 10000) is 0.0098. Looking them
+// up takes well under a second even on large inputs, where parsing takes far
+// longer, so there is nothing to gain from fewer, and four times as many
+// would only halve the margin.
+static const size_t ESTIMATE_SAMPLES = 10000;
+
+// With a deadline, only about one in this many bookmarks is searched at
+// first, then one in the next number, and so on.
+static const size_t STRIDES[] = { 64, 8, 1 };
+
 int Dupfind::run(int argc, char* argv[])
 {
+    itsStart    = Clock::now();
+    itsReadTime = std::time(0);
     itsOptions.parse(argc, argv);
 
-    Parser      parser(itsContainer);
+    if (not itsOptions.updateIndex.empty())
+    {
+        updateIndex();
+        return 0;
+    }
+
+    // The deadline counts from the start, so parsing, which may take long
+    // too, is watched as well.
+    std::thread watchdog;
+    if (itsOptions.deadline > 0 && not itsOptions.profile &&
+        not itsOptions.estimate && itsOptions.similarity == 0 &&
+        not itsOptions.query && itsOptions.buildIndex.empty())
+    {
+        watchdog = std::thread(&Dupfind::watchDeadline, this);
+    }
+
+    const bool  isIndexed = not itsOptions.indexDir.empty();
+    const char* processed = isIndexed ?
+        IndexFile(itsOptions.indexDir).read(itsContainer,
+                                            itsOptions.wordMode,
+                                            itsMarksDue) :
+        parse();
+    if (itsOptions.query)
+    {
+        query();
+        delete [] processed;
+        return 0;
+    }
+    if (not itsOptions.buildIndex.empty())
+    {
+        buildIndex();
+        delete [] processed;
+        return 0;
+    }
+    itsContainer.separate(itsOptions.crossFile);
+    {
+        std::lock_guard<std::mutex> lock(itsMutex);
+        itsProcessedBegin = processed;
+        itsProcessedEnd   = processed + strlen(processed);
+    }
+
+    // The bookmarks of an index are searched in the order they were sorted
+    // in, unless they must be sampled, chained or removed before the sort.
+    const bool gapped   = itsOptions.maxGap >= 0;
+    const bool isSorted = isIndexed && not itsOptions.estimate &&
+        not itsOptions.trees && not gapped && not itsOptions.winnow &&
+        (itsOptions.deadline == 0 || itsOptions.profile);
+    if (isIndexed && not isSorted)
+        itsContainer.restoreTextOrder();
+
+    if (itsOptions.estimate || itsOptions.similarity > 0)
+    {
+        if (itsOptions.estimate)
+            estimate();
+        else
+            reportSimilarFiles();
+        delete [] processed;
+        return 0;
+    }
+
+    if (itsOptions.trees)
+        reportCopiedTrees();
+
+    // A bookmark can only be part of a reported duplication if it has at
+    // least the proximity share of the minimum length in common with another,
+    // or as much as a chained match when gaps are allowed. Fingerprints are
+    // taken of the whole text, so all bookmarks are kept for them.
+    const size_t nrOfBookmarks = itsContainer.size();
+    const size_t minSame       =
+        size_t(itsOptions.minLength) * itsOptions.proximityFactor / 100;
+    if (gapped && not itsOptions.winnow)
+        itsContainer.removeUnique(GapChainer::MIN_MATCH_LENGTH);
+    else if (itsOptions.minLength > 0 && not itsOptions.winnow && isSorted)
+        itsContainer.removeUniqueSorted(minSame, itsOptions.minInstances);
+    else if (itsOptions.minLength > 0 && not itsOptions.winnow)
+        itsContainer.removeUnique(minSame, itsOptions.minInstances);
+    if (itsOptions.showStats && nrOfBookmarks > 0)
+        std::cerr << "Bookmarks: " << nrOfBookmarks << ", candidates: "
+                  << itsContainer.size() << " ("
+                  << (100 * itsContainer.size() + nrOfBookmarks / 2) /
+                     nrOfBookmarks
+                  << " %)\n";
+
+    if (itsOptions.profile)
+        reportProfile();
+    else if (itsOptions.deadline > 0)
+    {
+        searchUntilDeadline();
+        watchdog.join();
+    }
+    else
+    {
+        search(itsOptions.showStats);
+        printTotal();
+    }
+    delete [] processed;
+    return 0;
+}
+
+/**
+ * Parses the files into a processed text, which is returned, and bookmarks.
+ * Files that are in the cache, if there is one, are not parsed again.
+ */
+const char* Dupfind::parse()
+{
+    ParseCache* cache = itsOptions.cacheFile.empty() ? 0 :
+        new ParseCache(itsOptions.cacheFile);
+    Parser      parser(itsContainer, cache);
     const char* processed = parser.process(itsOptions.wordMode);
-    itsProcessedEnd = processed + strlen(processed);
+    itsMarksDue           = parser.marksDue();
+    if (cache != 0)
+    {
+        cache->save();
+        if (itsOptions.showStats)
+            std::cerr << "Parse cache: " << cache->nrOfHits() << " hits, "
+                      << cache->nrOfMisses() << " misses\n";
+        delete cache;
+    }
+    return processed;
+}
+
+/**
+ * Sorts all bookmarks, with none removed, and writes them to an index that
+ * later runs can search with any options.
+ */
+void Dupfind::buildIndex()
+{
+    // Only an LcpTable lets the bookmarks be removed after the sort.
+    Options options   = itsOptions;
+    options.lowMemory = false;
+    itsContainer.sort(options);
+    IndexFile(itsOptions.buildIndex).write(itsContainer, itsOptions.wordMode,
+                                           itsMarksDue, itsReadTime);
+    if (itsOptions.showStats)
+        std::cerr << "Index: " << Bookmark::nrOfFiles() << " files, "
+                  << itsContainer.size() << " bookmarks\n";
+}
+
+/**
+ * Brings an index up to date with the given files, in the given order. A
+ * file that is in the index is kept if it's as big and was last changed
+ * before the files of the index began to be read, or else if its text is the
+ * same. A file changed while the index was being built is compared, since the
+ * index may have its text from before the change. The processed text and
+ * bookmarks of the kept files are spliced in, and only the other files are
+ * parsed and sorted. Their bookmarks are then merged with the kept ones.
+ */
+void Dupfind::updateIndex()
+{
+    const IndexFile   index(itsOptions.updateIndex);
+    const int64_t     readTime = index.readTime();
+    BookmarkContainer old;
+    std::vector<bool> oldMarksDue;
+    const char* const oldText =
+        index.read(old, itsOptions.wordMode, oldMarksDue);
+
+    std::map<std::string, size_t> oldFileNrs;
+    for (size_t f = 0; f < Bookmark::nrOfFiles(); ++f)
+        oldFileNrs[Bookmark::fileName(f)] = f;
+
+    // The text of each file, and which file is kept for which.
+    const auto&              files = itsOptions.files;
+    std::vector<std::string> texts(files.size());
+    std::vector<size_t>      keptFor(Bookmark::nrOfFiles(), SIZE_MAX);
+    for (size_t f = 0; f < files.size(); ++f)
+    {
+        const std::string& name = files[f].first;
+        const auto         it   = oldFileNrs.find(name);
+        if (it != oldFileNrs.end() && keptFor[it->second] == SIZE_MAX)
+        {
+            texts[f] = Bookmark::fileText(it->second);
+            struct stat s;
+            if ((stat(name.c_str(), &s) == 0 &&
+                 size_t(s.st_size) + 1 == texts[f].size() &&
+                 s.st_mtime < readTime) ||
+                readFileIntoString(name.c_str()) == texts[f])
+            {
+                keptFor[it->second] = f;
+                continue;
+            }
+        }
+        texts[f] = readFileIntoString(name.c_str());
+    }
+
+    // The processed text and bookmarks of the kept files.
+    std::vector<ParseCache::Entry> entries(files.size());
+    const std::vector<size_t>      oldEofs = old.eofOffsets();
+    size_t                         markIx  = 0;
+    for (size_t o = 0; o < oldEofs.size(); ++o)
+    {
+        const size_t begin         = (o == 0) ? 0 : oldEofs[o - 1] + 1;
+        const size_t originalBegin = (o == 0) ? 0 : Bookmark::fileEnd(o - 1);
+        for (; markIx < old.nrOfMarks() &&
+               old.markOffset(markIx) <= oldEofs[o]; ++markIx)
+        {
+            if (keptFor[o] == SIZE_MAX)
+                continue;
+            ParseCache::Entry& entry = entries[keptFor[o]];
+            entry.markOffsets.push_back(old.markOffset(markIx) - begin);
+            entry.markOriginals.push_back(old.markOriginal(markIx) -
+                                          originalBegin);
+        }
+        if (keptFor[o] == SIZE_MAX)
+            continue;
+        ParseCache::Entry& entry = entries[keptFor[o]];
+        entry.processed.assign(oldText + begin, oldEofs[o] + 1 - begin);
+        entry.startsWithMark = oldMarksDue[o];
+        entry.endsWithMark   = oldMarksDue[o + 1];
+    }
+
+    Bookmark::clearFiles();
+    Parser parser(itsContainer);
+    for (size_t f = 0; f < files.size(); ++f)
+    {
+        Bookmark::addFile(files[f].first, texts[f], files[f].second);
+        if (not entries[f].processed.empty())
+            parser.reuse(f, &entries[f]);
+    }
+    const char* const processed = parser.process(itsOptions.wordMode);
+
+    // A kept file is parsed anyway if a bookmark wasn't due at its beginning
+    // like before, and its bookmarks are sorted like those of a new file.
+    const std::vector<size_t> eofs = itsContainer.eofOffsets();
+    std::vector<size_t>       newBegins(oldEofs.size(), SIZE_MAX);
+    size_t                    nrOfParsed = 0;
+    for (size_t o = 0; o < oldEofs.size(); ++o)
+        if (keptFor[o] != SIZE_MAX && parser.isReused(keptFor[o]))
+            newBegins[o] = (keptFor[o] == 0) ? 0 : eofs[keptFor[o] - 1] + 1;
+    for (size_t f = 0; f < files.size(); ++f)
+        if (not parser.isReused(f))
+            ++nrOfParsed;
+    itsContainer.sortUpdated(old, newBegins);
+    index.write(itsContainer, itsOptions.wordMode, parser.marksDue(),
+                itsReadTime);
+    if (itsOptions.showStats)
+        std::cerr << "Index: " << files.size() << " files, "
+                  << itsContainer.size() << " bookmarks, " << nrOfParsed
+                  << " files parsed\n";
+    delete [] oldText;
+    delete [] processed;
+}
+
+/**
+ * Looks up the text of the query files in the index and reports the longest
+ * stretches of it that are found there. The query comes first in each report,
+ * followed by the places that have most of the stretch in common with it. A
+ * query file that is in the index, under any name, is not looked up in
+ * itself, and stretches within a reported one are not reported again.
+ */
+void Dupfind::query()
+{
+    // A file is known by its device and inode, so that it's found in the
+    // index however its name is spelled.
+    typedef std::pair<dev_t, ino_t> FileId;
+    std::map<FileId, size_t> indexedFileNrs;
+    const size_t             nrOfIndexed = Bookmark::nrOfFiles();
+    struct stat              s;
+    for (size_t f = 0; f < nrOfIndexed; ++f)
+        if (stat(Bookmark::fileName(f).c_str(), &s) == 0)
+            indexedFileNrs[FileId(s.st_dev, s.st_ino)] = f;
+    const std::vector<size_t> eofs = itsContainer.eofOffsets();
+    for (size_t q = 0; q < itsOptions.files.size(); ++q)
+        Bookmark::addFile(itsOptions.files[q].first,
+                          itsOptions.files[q].second);
+
+    BookmarkContainer queries;
+    Parser            parser(queries);
+    const char* const text = parser.process(itsOptions.wordMode, nrOfIndexed);
+
+    size_t fileNr      = SIZE_MAX;
+    size_t skipBegin   = 0;
+    size_t skipEnd     = 0;
+    size_t coveredEnd  = 0;
+    int    nrOfReports = 0;
+    int    nrOfFound   = 0;
+    for (size_t ix = 0; ix < queries.size(); ++ix)
+    {
+        const Bookmark bookmark = queries[ix];
+        const size_t   offset   = queries.offset(ix);
+        if (bookmark.fileNr() != fileNr)
+        {
+            fileNr      = bookmark.fileNr();
+            coveredEnd  = 0;
+            nrOfReports = 0;
+            skipBegin = skipEnd = 0;
+            const auto it =
+                (stat(Bookmark::fileName(fileNr).c_str(), &s) == 0) ?
+                indexedFileNrs.find(FileId(s.st_dev, s.st_ino)) :
+                indexedFileNrs.end();
+            if (it != indexedFileNrs.end())
+            {
+                skipBegin = (it->second == 0) ? 0 : eofs[it->second - 1] + 1;
+                skipEnd   = eofs[it->second] + 1;
+            }
+        }
+        if (offset < coveredEnd ||
+            nrOfReports >= itsOptions.nrOfWantedReports)
+        {
+            continue;
+        }
+
+        size_t       found;
+        const size_t longest =
+            itsContainer.findLongest(text + offset, skipBegin, skipEnd, found);
+        if (longest == 0 || longest < size_t(itsOptions.minLength))
+            continue;
+        // Like the instances of a duplication, the places need only have the
+        // proximity share of the longest stretch in common with the query.
+        size_t first;
+        size_t last;
+        itsContainer.sameRange(found,
+                               std::max(size_t(itsOptions.minLength),
+                                        longest * itsOptions.proximityFactor /
+                                        100),
+                               first, last);
+        std::vector<size_t> instances;
+        for (size_t k = first; k <= last; ++k)
+            if (itsContainer.offset(k) < skipBegin ||
+                itsContainer.offset(k) >= skipEnd)
+            {
+                instances.push_back(k);
+            }
+        if (int(instances.size()) + 1 < itsOptions.minInstances)
+            continue;
+
+        // The places in the index in the order of the files.
+        std::sort(instances.begin(), instances.end(),
+                  [&](size_t a, size_t b) {
+                      return itsContainer.offset(a) < itsContainer.offset(b);
+                  });
+        Report report;
+        report.instances.push_back(bookmark);
+        report.lengths.push_back(longest);
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            report.instances.push_back(itsContainer[instances[i]]);
+            report.lengths.push_back(nrOfSameChars(
+                text + offset,
+                itsContainer.text() + itsContainer.offset(instances[i])));
+        }
+        printReport(report);
+        coveredEnd = offset + longest;
+        ++nrOfReports;
+        ++nrOfFound;
+    }
+    if (itsOptions.showStats)
+        std::cerr << "Queries: " << itsOptions.files.size() << " files, "
+                  << nrOfFound << " reports\n";
+    delete [] text;
+}
+
+/**
+ * Prints an estimate of what the total duplication would be, without finding
+ * the duplications.
+ */
+void Dupfind::estimate() const
+{
+    double       margin;
+    const double share = itsContainer.estimateDuplication(
+        std::max(itsOptions.minLength, 1), ESTIMATE_SAMPLES, margin);
+    cout << std::fixed << std::setprecision(1)
+         << "Duplication = " << 100 * share << " % +- " << 100 * margin
+         << " % (estimated from " << ESTIMATE_SAMPLES << " samples)\n";
+}
+
+/**
+ * Reports the pairs of files that are alike as a whole, most similar first,
+ * instead of the duplications within them.
+ */
+void Dupfind::reportSimilarFiles() const
+{
+    MinHasher hasher(itsProcessedBegin);
+    const std::vector<MinHasher::SimilarPair> pairs =
+        hasher.similarPairs(itsOptions.similarity);
+    if (itsOptions.showStats)
+        std::cerr << "Files: " << Bookmark::nrOfFiles()
+                  << ", candidate pairs: " << hasher.nrOfCandidates() << "\n";
+    int nrOfReports = 0;
+    for (size_t p = 0;
+         p < pairs.size() && nrOfReports < itsOptions.nrOfWantedReports; ++p)
+    {
+        if (Bookmark::setOf(pairs[p].first) != Bookmark::NO_SET &&
+            Bookmark::setOf(pairs[p].first) == Bookmark::setOf(pairs[p].second))
+        {
+            continue;
+        }
+        ++nrOfReports;
+        cout << Bookmark::fileName(pairs[p].first) << ":1:Similar files "
+             << nrOfReports << " (1st file, "
+             << int(100 * pairs[p].similarity + 0.5) << " % alike).\n"
+             << Bookmark::fileName(pairs[p].second) << ":1:Similar files "
+             << nrOfReports << " (2nd file).\n\n";
+    }
+}
+
+/**
+ * Reports the directories that are copies of each other and removes the
+ * bookmarks in the copied files, so that the duplications within them aren't
+ * reported again one by one.
+ */
+void Dupfind::reportCopiedTrees()
+{
+    const TreeHasher hasher(itsProcessedBegin,
+                            itsOptions.proximityFactor / 100.0);
+    const std::vector<TreeHasher::Copy>& copies = hasher.copies();
+    // The search that follows may be cut short by the watchdog, which prints
+    // under the mutex too, so the two reports can't be mixed up.
+    std::unique_lock<std::mutex> lock(itsMutex);
+    for (size_t c = 0; c < copies.size(); ++c)
+    {
+        for (size_t d = 0; d < copies[c].directories.size(); ++d)
+        {
+            cout << copies[c].directories[d] << ":Duplicated directory "
+                 << c + 1 << " (" << d + 1 << Bookmark::order(d + 1)
+                 << " instance";
+            if (d == 0)
+                cout << ", " << copies[c].nrOfFiles << " files, "
+                     << int(100 * copies[c].similarity + 0.5) << " % alike";
+            cout << ").\n";
+        }
+        cout << std::endl;
+    }
+    lock.unlock();
 
-    itsContainer.sort();
+    const std::vector<std::pair<size_t, size_t> > copied =
+        hasher.copiedFiles();
+    itsContainer.removeWithin(copied);
+    if (itsOptions.showStats)
+        std::cerr << "Copied directories: " << copies.size()
+                  << ", copied files left out: " << copied.size() << "\n";
+}
+
+/**
+ * Sorts the bookmarks and prints how many clones there are of each length,
+ * instead of reporting them.
+ */
+void Dupfind::reportProfile()
+{
+    // Bookmarks read from an index are sorted already.
+    if (not itsContainer.hasLcpTable())
+        itsContainer.sort(itsOptions);
+    const DuplicationProfile profile(itsContainer, itsOptions);
+    profile.print(cout);
+}
+
+/**
+ * Sorts the bookmarks and reports the duplications among them.
+ */
+void Dupfind::search(bool showStats)
+{
+    if (itsOptions.winnow)
+    {
+        reportWinnowed(showStats);
+        return;
+    }
+
+    const bool gapped = itsOptions.maxGap >= 0;
+
+    // When all duplications are wanted, it's faster to find them in one go,
+    // and the bookmarks need only be sorted as far as the minimum length.
+    const bool all = not gapped &&
+        itsOptions.nrOfWantedReports == INT_MAX && itsOptions.minLength > 0;
+
+    // Bookmarks read from an index are sorted already.
+    if (not itsContainer.hasLcpTable())
+        itsContainer.sort(itsOptions, all ? itsOptions.minLength : SIZE_MAX);
+    if (showStats && itsContainer.isRepetitive())
+        std::cerr << "Repetitive input, sorted with a suffix array\n";
+    if (showStats && itsContainer.nrOfRuns() > 0)
+        std::cerr << "Sorted in " << itsContainer.nrOfRuns()
+                  << " runs on disk\n";
+
+    if (gapped)
+        reportGapped();
+    else if (all)
+        reportAll();
+    else
+        for (int count = 0; count < itsOptions.nrOfWantedReports; ++count)
+            if (not reportOne())
+                break;
+}
+
+/**
+ * Searches a sample of the bookmarks first and then bigger ones, so that
+ * there is something to report if the deadline is reached before all
+ * bookmarks have been searched. The reports are kept until the search is
+ * done, or until the watchdog prints the best ones found so far.
+ */
+void Dupfind::searchUntilDeadline()
+{
+    BookmarkContainer candidates = std::move(itsContainer);
+    bool              isCutShort = false;
+    for (size_t level = 0; level < sizeof STRIDES / sizeof *STRIDES; ++level)
+    {
+        if (Clock::now() >= deadline())
+        {
+            isCutShort = true;
+            break;
+        }
+        const size_t stride = STRIDES[level];
+        if (stride == 1)
+            itsContainer = std::move(candidates);
+        else
+            itsContainer = candidates.sample(stride);
+
+        std::vector<Report> reports;
+        itsCollected = &reports;
+        search(itsOptions.showStats && stride == 1);
+        itsCollected = 0;
+
+        std::lock_guard<std::mutex> lock(itsMutex);
+        itsBest.swap(reports);
+        itsBestStride = stride;
+    }
+
+    std::unique_lock<std::mutex> lock(itsMutex);
+    // If the watchdog is printing already, it exits when it's done.
+    while (itsIsPrinting)
+        itsPrinting.wait(lock);
+    itsIsPrinting = true;
+    itsPrinting.notify_all();
+    lock.unlock();
+    printBest(not isCutShort);
+}
+
+/**
+ * Waits for the deadline, unless the search is done before that. If the
+ * search is still going on then, the best reports found so far are printed,
+ * and the program exits.
+ */
+void Dupfind::watchDeadline()
+{
+    std::unique_lock<std::mutex> lock(itsMutex);
+    if (itsPrinting.wait_until(lock, deadline(),
+                               [&] { return itsIsPrinting; }))
+    {
+        return;
+    }
+    itsIsPrinting = true;
+    printBest(false);
+    cout.flush();
+    std::_Exit(EXIT_SUCCESS);
+}
 
-    for (int count = 0; count < itsOptions.nrOfWantedReports; ++count)
-        if (not reportOne())
+Dupfind::Clock::time_point Dupfind::deadline() const
+{
+    return itsStart + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(itsOptions.deadline));
+}
+
+/**
+ * Prints the best reports found so far, followed by a note if they are not
+ * all there would be. When printing too may stop at the deadline, it does so
+ * between two reports.
+ */
+void Dupfind::printBest(bool stopAtDeadline)
+{
+    size_t count = 0;
+    for (; count < itsBest.size(); ++count)
+    {
+        if (stopAtDeadline && Clock::now() >= deadline())
             break;
+        printReport(itsBest[count]);
+    }
+    printTotal();
 
+    const char* what = itsOptions.wordMode ? "words" : "lines";
+    if (itsBestStride == 0)
+        cout << "Partial result: the deadline was reached before any "
+             << "duplication was found.\n";
+    else if (count < itsBest.size())
+        cout << "Partial result: the deadline was reached after " << count
+             << " of " << itsBest.size() << " duplications were reported.\n";
+    else if (itsBestStride > 1)
+        cout << "Partial result: the deadline was reached when only about "
+             << "1 in " << itsBestStride << " " << what
+             << " had been searched.\n";
+}
+
+void Dupfind::printTotal() const
+{
     if (itsOptions.totalReport != Options::NO_TOTAL)
     {
-        const int length = itsProcessedEnd - processed;
+        // Nothing has been parsed yet if the deadline came first.
+        const size_t length = itsProcessedEnd - itsProcessedBegin;
         cout << "Duplication = " << Bookmark::getTotalNrOfLines() << " lines, "
-             << (100 * itsTotalDuplication + length / 2) / length << " %\n";
+             << ((length == 0) ? 0 :
+                 (100 * itsTotalDuplication + length / 2) / length)
+             << " %\n";
     }
-    delete [] processed;
-    return 0;
+}
+
+/**
+ * Prints a report right away, or keeps it if the search may be cut short.
+ */
+void Dupfind::addReport(Report& report)
+{
+    if (itsCollected != 0)
+    {
+        itsCollected->push_back(Report());
+        itsCollected->back().instances.swap(report.instances);
+        itsCollected->back().lengths.swap(report.lengths);
+    }
+    else
+        printReport(report);
+}
+
+void Dupfind::printReport(const Report& report)
+{
+    Duplication duplication;
+    duplication.instances = report.instances.size();
+    for (size_t i = 0; i < report.instances.size(); ++i)
+    {
+        duplication.longestSame = report.lengths[i];
+        report.instances[i].report(duplication, i + 1, itsOptions);
+        itsTotalDuplication += report.lengths[i];
+    }
+    cout << std::endl;
 }
 
 /**
@@ -57,12 +695,13 @@ bool Dupfind::reportOne()
         return false;
 
     // Report all found instances (exact and approximate matches).
+    Report report;
     for (int i = 0; i < worst.instances; ++i)
-        itsContainer.report(worst.indexOf1stInstance + i, worst, i + 1,
-                            itsOptions);
-    cout << std::endl;
-
-    itsTotalDuplication += worst.longestSame * worst.instances;
+    {
+        report.instances.push_back(itsContainer[worst.indexOf1stInstance + i]);
+        report.lengths.push_back(worst.longestSame);
+    }
+    addReport(report);
 
     // Clear bookmarks that point to something within the reported area.
     // This is to avoid reporting the same section more than once.
@@ -70,28 +709,177 @@ bool Dupfind::reportOne()
     return true;
 }
 
-Duplication Dupfind::findWorst() const
+/**
+ * Reports all duplications that are long enough, exactly as calling
+ * reportOne() until it returns false would.
+ */
+void Dupfind::reportAll()
 {
-    Duplication result;
+    RepeatEnumerator    enumerator(itsContainer, itsOptions.minLength,
+                                   itsOptions.proximityFactor,
+                                   itsOptions.minInstances);
+    Duplication         duplication;
+    std::vector<size_t> instances;
+    while (enumerator.next(duplication, instances))
+    {
+        Report report;
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            report.instances.push_back(itsContainer[instances[i]]);
+            report.lengths.push_back(duplication.longestSame);
+        }
+        addReport(report);
+    }
+}
+
+/**
+ * Finds the first of the runs of neighbors from begin up to end that have
+ * the longest common substring. A run has as many bookmarks as a duplication
+ * must have instances, so it is a pair unless -i is given, and its common
+ * substring is as long as the fewest common characters of its pairs. Runs
+ * with fewer common characters than the longest found in any chunk so far
+ * are skipped quickly.
+ */
+void Dupfind::findLongestPair(size_t               begin,
+                              size_t               end,
+                              std::atomic<size_t>& longestInAnyChunk,
+                              Duplication&         result) const
+{
+    const size_t nrOfPairs = itsOptions.minInstances - 1; // In each run.
+    for (size_t markIx = begin;
+         markIx < end && markIx + nrOfPairs < itsContainer.size(); ++markIx)
+    {
+        // Between two parts of the text, the longest run across them is next
+        // to each other in sorted order, like the longest of all runs.
+        bool isMixed = false;
+        for (size_t ix = markIx; ix < markIx + nrOfPairs && not isMixed; ++ix)
+            isMixed = itsContainer.isMixed(ix, ix + 1);
+        if (not isMixed)
+            continue;
 
-    // Find the two bookmarks that have the longest common substring.
-    for (size_t markIx = 0; markIx + 1 < itsContainer.size(); ++markIx)
-        if (itsContainer.same(markIx, markIx + 1, result.longestSame,
-                              itsProcessedEnd))
+        // A run with as many common characters as in a later chunk still
+        // wins, since it comes first.
+        const size_t longest = longestInAnyChunk;
+        const size_t atLeast =
+            std::max(result.longestSame, (longest > 0) ? longest - 1 : 0);
+        size_t same = SIZE_MAX;
+        for (size_t ix = markIx; ix < markIx + nrOfPairs && same > 0; ++ix)
+            if (itsContainer.same(ix, ix + 1, atLeast, itsProcessedEnd))
+                same = std::min(same, itsContainer.nrOfSame(ix, ix + 1));
+            else
+                same = 0;
+        if (same > result.longestSame)
         {
-            const int same = itsContainer.nrOfSame(markIx, markIx + 1);
-            if (same > result.longestSame)
+            result.indexOf1stInstance = markIx;
+            result.longestSame        = same;
+            size_t expected = longestInAnyChunk;
+            while (same > expected &&
+                   not longestInAnyChunk.compare_exchange_weak(expected, same))
             {
-                result.indexOf1stInstance = markIx;
-                result.longestSame        = same;
             }
         }
+    }
+}
+
+/**
+ * Reports the longest duplications where exact matches are chained across
+ * small gaps, each with two instances. None are reported if more instances
+ * are wanted.
+ */
+void Dupfind::reportGapped()
+{
+    if (itsOptions.minInstances > 2)
+        return;
+    const GapChainer chainer(itsContainer, itsOptions.maxGap);
+    const std::vector<GapChainer::Clone> clones =
+        chainer.clones(std::max(itsOptions.minLength, 0));
+    for (size_t c = 0;
+         c < clones.size() && c < size_t(itsOptions.nrOfWantedReports); ++c)
+    {
+        Report report;
+        report.instances.push_back(itsContainer[clones[c].firstIx]);
+        report.lengths.push_back(clones[c].firstLength);
+        report.instances.push_back(itsContainer[clones[c].secondIx]);
+        report.lengths.push_back(clones[c].secondLength);
+        addReport(report);
+    }
+}
+
+/**
+ * Reports the longest duplications that are found from fingerprints of the
+ * text, without sorting the bookmarks.
+ */
+void Dupfind::reportWinnowed(bool showStats)
+{
+    const Winnower winnower(itsContainer, std::max(itsOptions.minLength, 0),
+                            itsOptions.minInstances);
+    if (showStats)
+        std::cerr << "Fingerprints: " << winnower.nrOfFingerprints()
+                  << " of " << winnower.kgramLength()
+                  << " characters, one in each window of "
+                  << winnower.windowLength() << "\n";
+    const std::vector<Winnower::Clone> clones = winnower.clones();
+    for (size_t c = 0;
+         c < clones.size() && c < size_t(itsOptions.nrOfWantedReports); ++c)
+    {
+        Report report;
+        for (size_t i = 0; i < clones[c].ixs.size(); ++i)
+        {
+            report.instances.push_back(itsContainer[clones[c].ixs[i]]);
+            report.lengths.push_back(clones[c].length);
+        }
+        addReport(report);
+    }
+}
 
-    if (result.longestSame >= itsOptions.minLength)
+Duplication Dupfind::findWorst() const
+{
+    Duplication result;
+
+    // Find the two bookmarks that have the longest common substring. Each
+    // thread scans a chunk of the pairs and the first pair with the longest
+    // substring wins, just as if they were scanned one by one.
+    const size_t nrOfPairs =
+        (itsContainer.size() > 0) ? itsContainer.size() - 1 : 0;
+    const size_t nrOfChunks =
+        std::max<size_t>(1, std::min<size_t>(itsOptions.nrOfThreads,
+                                             nrOfPairs / MIN_PAIRS_PER_THREAD));
+    std::vector<Duplication> chunkResults(nrOfChunks);
+    std::atomic<size_t>      longestInAnyChunk(0);
+    auto scanChunk = [&](size_t chunk) {
+        findLongestPair(nrOfPairs * chunk / nrOfChunks,
+                        nrOfPairs * (chunk + 1) / nrOfChunks,
+                        longestInAnyChunk, chunkResults[chunk]);
+    };
+    std::vector<std::thread> threads;
+    for (size_t chunk = 1; chunk < nrOfChunks; ++chunk)
+        threads.push_back(std::thread(scanChunk, chunk));
+    scanChunk(0);
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+    for (size_t chunk = 0; chunk < nrOfChunks; ++chunk)
+        if (chunkResults[chunk].longestSame > result.longestSame)
+            result = chunkResults[chunk];
+
+    if (ptrdiff_t(result.longestSame) >= itsOptions.minLength)
     {
-        int almostLongest =
+        size_t almostLongest =
             (result.longestSame * itsOptions.proximityFactor) / 100;
 
+        if (itsContainer.hasLcpTable())
+        {
+            // All approximate matches are found in one lookup, since they
+            // make up a range in sorted order.
+            size_t first;
+            size_t last;
+            itsContainer.sameRange(result.indexOf1stInstance, almostLongest,
+                                   first, last);
+            result.instances          = last - first + 1;
+            result.indexOf1stInstance = first;
+            result.longestSame        = itsContainer.nrOfSame(first, last);
+            return result;
+        }
+
         // Look for approximate matches in strings just before the current
         // pair.
         int stepsBackward = expandSearch(result, almostLongest, -1, -1);
@@ -105,16 +893,16 @@ Duplication Dupfind::findWorst() const
 }
 
 int Dupfind::expandSearch(Duplication& duplication,
-                          int          almostLongest,
+                          size_t       almostLongest,
                           int          startingPoint,
                           int          loopIncrement) const
 {
-    int startIndex = duplication.indexOf1stInstance + startingPoint;
-    int i = startIndex;
-    for (; i >= 0 && i < int(itsContainer.size()); i += loopIncrement)
+    ptrdiff_t startIndex = duplication.indexOf1stInstance + startingPoint;
+    ptrdiff_t i = startIndex;
+    for (; i >= 0 && i < ptrdiff_t(itsContainer.size()); i += loopIncrement)
     {
-        const int same = itsContainer.nrOfSame(duplication.indexOf1stInstance,
-                                               i);
+        const size_t same =
+            itsContainer.nrOfSame(duplication.indexOf1stInstance, i);
         if (same < almostLongest)
             break;
         duplication.longestSame = std::min(duplication.longestSame, same);
@@ -4,29 +4,95 @@
 #include "bookmark_container.hh"
 #include "options.hh"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
 struct Duplication;
 
 class Dupfind
 {
 public:
-    Dupfind(): itsTotalDuplication(0) {}
+    Dupfind():
+        itsTotalDuplication(0),
+        itsProcessedBegin(0),
+        itsProcessedEnd(0),
+        itsReadTime(0),
+        itsCollected(0),
+        itsBestStride(0),
+        itsIsPrinting(false) {}
 
     int run(int argc, char* argv[]);
 
 private:
+    typedef std::chrono::steady_clock Clock;
+
+    // A duplication that has been found, with the length of each instance.
+    struct Report
+    {
+        std::vector<Bookmark> instances;
+        std::vector<size_t>   lengths;
+    };
+
+    const char* parse();
+    void        buildIndex();
+    void        updateIndex();
+    void        query();
+
+    void estimate() const;
+    void reportSimilarFiles() const;
+    void reportCopiedTrees();
+    void reportProfile();
+    void search(bool showStats);
+    void searchUntilDeadline();
+    void watchDeadline();
+
+    Clock::time_point deadline() const;
+
+    void printBest(bool stopAtDeadline);
+    void printTotal() const;
+    void addReport(Report& report);
+    void printReport(const Report& report);
+
     bool reportOne();
 
+    void reportAll();
+
+    void reportGapped();
+
+    void reportWinnowed(bool showStats);
+
+    void findLongestPair(size_t               begin,
+                         size_t               end,
+                         std::atomic<size_t>& longestInAnyChunk,
+                         Duplication&         result) const;
+
     Duplication findWorst() const;
 
     int expandSearch(Duplication& duplication,
-                     int          almostLongest,
+                     size_t       almostLongest,
                      int          startingPoint,
                      int          loopIncrement) const;
 
     Options           itsOptions;
     BookmarkContainer itsContainer;
-    int               itsTotalDuplication;
+    size_t            itsTotalDuplication;
+    const char*       itsProcessedBegin;
     const char*       itsProcessedEnd;
+    Clock::time_point itsStart;
+    int64_t           itsReadTime; // In seconds since the epoch.
+    std::vector<bool> itsMarksDue; // At each file, for an index.
+
+    // With a deadline, the reports are kept until the search is done.
+    std::vector<Report>*    itsCollected;
+    std::vector<Report>     itsBest;       // Found so far.
+    size_t                  itsBestStride; // Of the sample, 0 if none yet.
+    bool                    itsIsPrinting;
+    std::mutex              itsMutex;
+    std::condition_variable itsPrinting;
 };
 
 #endif
@@ -1,13 +1,15 @@
 #ifndef DUPLICATION_HH
 #define DUPLICATION_HH
 
+#include <cstdlib> // size_t
+
 struct Duplication
 {
     Duplication(): instances(0), longestSame(0), indexOf1stInstance(0) {}
 
-    int instances;
-    int longestSame;
-    int indexOf1stInstance;
+    int    instances;
+    size_t longestSame;
+    size_t indexOf1stInstance;
 };
 
 #endif
@@ -0,0 +1,258 @@
+#include "duplication_profile.hh"
+#include "bookmark.hh"
+#include "bookmark_container.hh"
+#include "file.hh" // SPECIAL_EOF
+#include "options.hh"
+
+#include <algorithm> // lower_bound, max, sort, upper_bound
+#include <cstring>   // memchr
+#include <iomanip>   // setw
+#include <sstream>
+#include <utility>   // move, pair
+
+const size_t DuplicationProfile::BUCKET_BOUNDS[] = { 100, 200, 500 };
+
+// The key of an interval before anything is known about the text before its
+// bookmarks, and after the text is known to differ.
+static const uint64_t UNSET   = 0;
+static const uint64_t DIVERSE = 1;
+
+static const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+static const uint64_t FNV_PRIME  = 0x100000001b3ULL;
+
+DuplicationProfile::DuplicationProfile(const BookmarkContainer& container,
+                                       const Options&           options):
+    itsContainer(container),
+    itsOptions(options),
+    itsTextOrder(container.size())
+{
+    const size_t minLength = std::max(options.minLength, 1);
+    itsLengths.push_back(minLength);
+    for (size_t b = 0; b < sizeof BUCKET_BOUNDS / sizeof *BUCKET_BOUNDS; ++b)
+        if (BUCKET_BOUNDS[b] > minLength)
+            itsLengths.push_back(BUCKET_BOUNDS[b]);
+    itsBuckets[""].resize(itsLengths.size());
+
+    const size_t size = container.size();
+    for (size_t ix = 0; ix < size; ++ix)
+        itsTextOrder[ix] = container.offset(ix);
+    std::sort(itsTextOrder.begin(), itsTextOrder.end());
+    if (size < 2)
+        return;
+
+    // The intervals that may still grow, with the one that holds all
+    // bookmarks at the bottom. When the common characters drop below those
+    // of an interval, it ends.
+    std::vector<Interval> stack(1);
+    stack[0].same    = 0;
+    stack[0].begin   = 0;
+    stack[0].left    = UNSET;
+    stack[0].isMixed = false;
+    uint64_t key = leftKey(0);
+    for (size_t ix = 1; ix <= size; ++ix)
+    {
+        const size_t same  = (ix < size) ? container.nrOfSame(ix - 1, ix) : 0;
+        size_t       begin = ix - 1;
+        Interval     child;
+        bool         hasChild = false;
+        while (same < stack.back().same)
+        {
+            // The pending clones of the interval that ended before are
+            // within this one.
+            std::vector<Clone> pending;
+            pending.swap(child.pending);
+            child = std::move(stack.back());
+            stack.pop_back();
+            child.pending.insert(child.pending.end(), pending.begin(),
+                                 pending.end());
+            end(child, ix);
+            merge(stack.back(), child.left, child.isMixed);
+            begin    = child.begin;
+            hasChild = true;
+        }
+        if (same > stack.back().same)
+        {
+            Interval interval;
+            interval.same    = same;
+            interval.begin   = begin;
+            interval.left    = UNSET;
+            interval.isMixed = false;
+            if (hasChild)
+            {
+                merge(interval, child.left, child.isMixed);
+                interval.pending.swap(child.pending);
+            }
+            stack.push_back(interval);
+        }
+        else if (hasChild)
+        {
+            stack.back().pending.insert(stack.back().pending.end(),
+                                        child.pending.begin(),
+                                        child.pending.end());
+        }
+        if (ix == size)
+            break;
+        const uint64_t nextKey = leftKey(ix);
+        merge(stack.back(), key, container.isMixed(ix - 1, ix));
+        merge(stack.back(), nextKey, false);
+        key = nextKey;
+    }
+    end(stack[0], size);
+}
+
+void DuplicationProfile::print(std::ostream& os) const
+{
+    os << "Duplication profile of clones of at least " << itsLengths[0]
+       << " characters:\n"
+       << std::left << std::setw(12) << "Ending" << std::setw(12)
+       << "Characters" << std::right << std::setw(10) << "Clones"
+       << std::setw(11) << "Instances" << std::setw(10) << "Lines" << "\n";
+    // The total comes last, with all of its buckets.
+    for (auto it = itsBuckets.begin(); it != itsBuckets.end(); ++it)
+        if (not it->first.empty())
+            printRows(os, it->first, it->second, false);
+    printRows(os, "total", itsBuckets.find("")->second, true);
+}
+
+void DuplicationProfile::printRows(std::ostream&              os,
+                                   const std::string&         ending,
+                                   const std::vector<Bucket>& buckets,
+                                   bool                       showEmpty) const
+{
+    for (size_t b = 0; b < itsLengths.size(); ++b)
+    {
+        if (buckets[b].clones == 0 && not showEmpty)
+            continue;
+        std::ostringstream lengths;
+        lengths << itsLengths[b] << "-";
+        if (b + 1 < itsLengths.size())
+            lengths << itsLengths[b + 1] - 1;
+        os << std::left << std::setw(12) << ending << std::setw(12)
+           << lengths.str() << std::right << std::setw(10)
+           << buckets[b].clones << std::setw(11) << buckets[b].instances
+           << std::setw(10) << buckets[b].lines << "\n";
+    }
+}
+
+/**
+ * Returns a key of the text from the previous bookmark in text order up to
+ * the one at the index, which is the same for two bookmarks if the text is,
+ * or DIVERSE if there is no previous bookmark in the same file.
+ */
+uint64_t DuplicationProfile::leftKey(size_t ix) const
+{
+    const size_t offset = itsContainer.offset(ix);
+    const auto   it     =
+        std::lower_bound(itsTextOrder.begin(), itsTextOrder.end(), offset);
+    if (it == itsTextOrder.begin())
+        return DIVERSE;
+    const size_t previous = *(it - 1);
+    const char*  text     = itsContainer.text();
+    if (std::memchr(text + previous, SPECIAL_EOF, offset - previous) != 0)
+        return DIVERSE;
+
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = previous; i < offset; ++i)
+        hash = (hash ^ static_cast<unsigned char>(text[i])) * FNV_PRIME;
+    hash = (hash ^ (offset - previous)) * FNV_PRIME;
+    return (hash > DIVERSE) ? hash : hash + 2;
+}
+
+void DuplicationProfile::merge(Interval& interval,
+                               uint64_t  left,
+                               bool      isMixed) const
+{
+    if (interval.left == UNSET)
+        interval.left = left;
+    else if (left != UNSET && left != interval.left)
+        interval.left = DIVERSE;
+    interval.isMixed = interval.isMixed || isMixed;
+}
+
+/**
+ * Ends an interval before the given index. If it's a clone, the overlapping
+ * clones within it are dropped, and it's counted unless it overlaps too. If
+ * not, and it's too short to be a clone, the pending clones are counted.
+ * Otherwise they are left pending for the interval around it.
+ */
+void DuplicationProfile::end(Interval& interval, size_t end)
+{
+    Clone clone;
+    if (interval.same < itsLengths[0])
+    {
+        for (size_t c = 0; c < interval.pending.size(); ++c)
+            add(interval.pending[c]);
+        interval.pending.clear();
+    }
+    else if (interval.left == DIVERSE && toClone(interval, end, clone))
+    {
+        interval.pending.clear();
+        if (clone.isOverlapping)
+            interval.pending.push_back(clone);
+        else
+            add(clone);
+    }
+}
+
+/**
+ * Makes a clone of the bookmarks in an interval that ends before the given
+ * index. Returns false if it has too few instances, or if they are all in the
+ * same part of the text when only clones across parts are wanted. Its lines
+ * are those of the text that its instances cover.
+ */
+bool DuplicationProfile::toClone(const Interval& interval,
+                                 size_t          end,
+                                 Clone&          clone) const
+{
+    clone.instances = end - interval.begin;
+    if (clone.instances < size_t(itsOptions.minInstances) ||
+        (itsContainer.isSeparated() && not interval.isMixed))
+    {
+        return false;
+    }
+
+    std::vector<std::pair<size_t, size_t> > instances; // Offset and index.
+    for (size_t ix = interval.begin; ix < end; ++ix)
+        instances.push_back(std::make_pair(itsContainer.offset(ix), ix));
+    std::sort(instances.begin(), instances.end());
+
+    clone.lines         = 0;
+    clone.isOverlapping = false;
+    for (size_t i = 0; i < instances.size();)
+    {
+        const size_t first     = i;
+        size_t       coveredTo = instances[i].first + interval.same;
+        for (++i; i < instances.size() && instances[i].first <= coveredTo; ++i)
+        {
+            clone.isOverlapping = clone.isOverlapping ||
+                instances[i].first < coveredTo;
+            coveredTo = std::max(coveredTo,
+                                 instances[i].first + interval.same);
+        }
+        clone.lines += itsContainer[instances[first].second].nrOfLines(
+            coveredTo - instances[first].first, itsOptions.wordMode);
+    }
+
+    const std::string& name =
+        Bookmark::fileName(itsContainer[instances[0].second].fileNr());
+    const size_t dot   = name.rfind('.');
+    const size_t slash = name.rfind('/');
+    clone.ending = (dot != std::string::npos &&
+                    (slash == std::string::npos || dot > slash)) ?
+        name.substr(dot) : "(none)";
+    clone.bucket = std::upper_bound(itsLengths.begin(), itsLengths.end(),
+                                    interval.same) - itsLengths.begin() - 1;
+    return true;
+}
+
+void DuplicationProfile::add(const Clone& clone)
+{
+    for (int total = 0; total < 2; ++total)
+    {
+        std::vector<Bucket>& buckets = itsBuckets[total ? "" : clone.ending];
+        buckets.resize(itsLengths.size());
+        ++buckets[clone.bucket].clones;
+        buckets[clone.bucket].instances += clone.instances;
+        buckets[clone.bucket].lines     += clone.lines;
+    }
+}
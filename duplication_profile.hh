@@ -0,0 +1,96 @@
+#ifndef DUPLICATION_PROFILE_HH
+#define DUPLICATION_PROFILE_HH
+
+#include <cstdint>
+#include <cstdlib> // size_t
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class BookmarkContainer;
+class Options;
+
+/**
+ * Sums up how much duplication there is by the length of the clones and by
+ * the ending of the file names, without finding and reporting them one by
+ * one.
+ *
+ * A clone is a set of two or more bookmarks whose text is the same for as
+ * many characters, and differs after that between at least two of them.
+ * Those are the intervals of neighbors in sorted order whose common
+ * characters are all at least that many, and they are found in one pass with
+ * a stack like the nodes of a suffix tree. A clone is left out if its text is
+ * preceded by the same text back to the previous bookmark in all instances,
+ * since it's then the end of a longer clone. That is found from a key of the
+ * preceding text at each bookmark, which the intervals inherit from the ones
+ * within them. The proximity factor isn't used, so the clones are exact.
+ *
+ * In a run of repeated lines, such as a generated table, the clones within
+ * the run overlap themselves, with fewer instances the longer they are. Only
+ * the shortest one, with all the lines as instances, is counted then: a
+ * clone whose instances overlap is kept pending until the interval around it
+ * is done, and dropped if that is a clone too.
+ */
+class DuplicationProfile
+{
+public:
+    // The container must be sorted all the way.
+    DuplicationProfile(const BookmarkContainer& container,
+                       const Options&           options);
+
+    // The lower bounds of the length buckets, besides the minimum length.
+    static const size_t BUCKET_BOUNDS[];
+
+    void print(std::ostream& os) const;
+
+private:
+    struct Bucket
+    {
+        Bucket(): clones(0), instances(0), lines(0) {}
+        size_t clones;
+        size_t instances;
+        size_t lines;     // In the text that the instances cover.
+    };
+
+    struct Clone
+    {
+        std::string ending;    // Of the file where it first occurs.
+        size_t      bucket;
+        size_t      instances;
+        size_t      lines;
+        bool        isOverlapping;
+    };
+
+    // The common characters of the bookmarks in an interval, what is known
+    // about the text before them, whether they are in different parts of the
+    // text, and the overlapping clones within it.
+    struct Interval
+    {
+        size_t             same;
+        size_t             begin;
+        uint64_t           left;
+        bool               isMixed;
+        std::vector<Clone> pending;
+    };
+
+    uint64_t leftKey(size_t ix) const;
+    void     merge(Interval& interval, uint64_t left, bool isMixed) const;
+    void     end(Interval& interval, size_t end);
+    bool     toClone(const Interval& interval, size_t end, Clone& clone) const;
+    void     add(const Clone& clone);
+    void     printRows(std::ostream&              os,
+                       const std::string&         ending,
+                       const std::vector<Bucket>& buckets,
+                       bool                       showEmpty) const;
+
+    const BookmarkContainer& itsContainer;
+    const Options&           itsOptions;
+    std::vector<size_t>      itsLengths;     // Lower bound of each bucket.
+    std::vector<size_t>      itsTextOrder;   // The offsets, in text order.
+
+    // By file ending, with the total under the empty string.
+    std::map<std::string, std::vector<Bucket> > itsBuckets;
+};
+
+#endif
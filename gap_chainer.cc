@@ -0,0 +1,202 @@
+#include "gap_chainer.hh"
+#include "bookmark_container.hh"
+#include "interval_set.hh"
+
+#include <algorithm> // lower_bound, max, sort, swap
+#include <cstdint>   // SIZE_MAX
+#include <map>
+
+static const size_t NONE = SIZE_MAX;
+
+namespace
+{
+    // Matches chained so far.
+    struct Chain
+    {
+        size_t firstIx;
+        size_t secondIx;
+        size_t firstBegin;
+        size_t secondBegin;
+        size_t lastFirst;  // Where the last match starts.
+        size_t lastSecond;
+        size_t firstEnd;   // Where the last match ends.
+        size_t secondEnd;
+        size_t matched;    // Characters in the matches.
+        std::multimap<size_t, size_t>::iterator entry;
+    };
+}
+
+GapChainer::GapChainer(const BookmarkContainer& container, size_t maxGap):
+    itsContainer(container),
+    itsMaxGap(maxGap),
+    itsEofs(container.eofOffsets())
+{
+    const std::vector<Match> matches = findMatches();
+
+    // The chains that may still be continued, by the diagonal of their last
+    // match.
+    std::vector<Chain>            chains;
+    std::multimap<size_t, size_t> ends;
+    for (size_t m = 0; m < matches.size(); ++m)
+    {
+        const Match& match    = matches[m];
+        const size_t diagonal = match.second - match.first;
+        size_t       best     = NONE;
+        auto it = ends.lower_bound((diagonal > maxGap) ? diagonal - maxGap : 0);
+        while (it != ends.end() && it->first <= diagonal + maxGap)
+        {
+            const Chain& chain = chains[it->second];
+            // The matches come in text order, so a chain that ends too far
+            // back can't be continued by any later match either.
+            if (chain.firstEnd + maxGap < match.first)
+            {
+                it = ends.erase(it);
+                continue;
+            }
+            if (chain.firstEnd <= match.first &&
+                chain.secondEnd <= match.second &&
+                match.second - chain.secondEnd <= maxGap &&
+                fileOf(chain.lastFirst) == fileOf(match.first) &&
+                fileOf(chain.lastSecond) == fileOf(match.second) &&
+                (best == NONE || chain.matched > chains[best].matched))
+            {
+                best = it->second;
+            }
+            ++it;
+        }
+
+        if (best == NONE)
+        {
+            Chain chain;
+            chain.firstIx     = match.firstIx;
+            chain.secondIx    = match.secondIx;
+            chain.firstBegin  = match.first;
+            chain.secondBegin = match.second;
+            chain.matched     = 0;
+            chains.push_back(chain);
+            best = chains.size() - 1;
+        }
+        else
+            ends.erase(chains[best].entry);
+        Chain& chain     = chains[best];
+        chain.lastFirst  = match.first;
+        chain.lastSecond = match.second;
+        chain.firstEnd   = match.first + match.length;
+        chain.secondEnd  = match.second + match.length;
+        chain.matched   += match.length;
+        chain.entry      = ends.insert(std::make_pair(diagonal, best));
+    }
+
+    for (size_t c = 0; c < chains.size(); ++c)
+    {
+        Clone clone;
+        clone.firstIx      = chains[c].firstIx;
+        clone.secondIx     = chains[c].secondIx;
+        clone.firstLength  = chains[c].firstEnd - chains[c].firstBegin;
+        clone.secondLength = chains[c].secondEnd - chains[c].secondBegin;
+        itsClones.push_back(clone);
+    }
+}
+
+std::vector<GapChainer::Clone> GapChainer::clones(size_t minLength) const
+{
+    std::vector<Clone> candidates;
+    for (size_t c = 0; c < itsClones.size(); ++c)
+        if (itsClones[c].firstLength >= minLength)
+            candidates.push_back(itsClones[c]);
+    std::sort(candidates.begin(), candidates.end(),
+              [&](const Clone& a, const Clone& b) {
+                  if (a.firstLength != b.firstLength)
+                      return a.firstLength > b.firstLength;
+                  if (a.firstIx != b.firstIx)
+                      return itsContainer.offset(a.firstIx) <
+                             itsContainer.offset(b.firstIx);
+                  return itsContainer.offset(a.secondIx) <
+                         itsContainer.offset(b.secondIx);
+              });
+
+    std::vector<Clone> result;
+    IntervalSet        covered;
+    for (size_t c = 0; c < candidates.size(); ++c)
+    {
+        const size_t first  = itsContainer.offset(candidates[c].firstIx);
+        const size_t second = itsContainer.offset(candidates[c].secondIx);
+        const size_t firstEnd  = first + candidates[c].firstLength;
+        const size_t secondEnd = second + candidates[c].secondLength;
+        if (covered.contains(first, firstEnd) &&
+            covered.contains(second, secondEnd))
+        {
+            continue;
+        }
+        covered.insert(first, firstEnd);
+        covered.insert(second, secondEnd);
+        result.push_back(candidates[c]);
+    }
+    return result;
+}
+
+/**
+ * Returns the maximal exact matches between neighbors in sorted order, in
+ * text order.
+ */
+std::vector<GapChainer::Match> GapChainer::findMatches() const
+{
+    std::vector<Match> pairs;
+    for (size_t ix = 0; ix + 1 < itsContainer.size(); ++ix)
+    {
+        if (not itsContainer.isMixed(ix, ix + 1))
+            continue;
+        Match pair;
+        pair.length = itsContainer.nrOfSame(ix, ix + 1);
+        if (pair.length < MIN_MATCH_LENGTH)
+            continue;
+        pair.first    = itsContainer.offset(ix);
+        pair.second   = itsContainer.offset(ix + 1);
+        pair.firstIx  = ix;
+        pair.secondIx = ix + 1;
+        if (pair.first > pair.second)
+        {
+            std::swap(pair.first, pair.second);
+            std::swap(pair.firstIx, pair.secondIx);
+        }
+        pairs.push_back(pair);
+    }
+
+    // Later bookmarks within a duplication give overlapping pairs on the same
+    // diagonal.
+    std::sort(pairs.begin(), pairs.end(), [](const Match& a, const Match& b) {
+        const size_t diagonalA = a.second - a.first;
+        const size_t diagonalB = b.second - b.first;
+        return diagonalA < diagonalB ||
+            (diagonalA == diagonalB && a.first < b.first);
+    });
+    std::vector<Match> matches;
+    for (size_t p = 0; p < pairs.size(); ++p)
+    {
+        if (not matches.empty())
+        {
+            Match& last = matches.back();
+            if (last.second - last.first == pairs[p].second - pairs[p].first &&
+                pairs[p].first <= last.first + last.length)
+            {
+                last.length = std::max(last.length, pairs[p].first +
+                                       pairs[p].length - last.first);
+                continue;
+            }
+        }
+        matches.push_back(pairs[p]);
+    }
+
+    std::sort(matches.begin(), matches.end(),
+              [](const Match& a, const Match& b) {
+                  return a.first < b.first ||
+                      (a.first == b.first && a.second < b.second);
+              });
+    return matches;
+}
+
+size_t GapChainer::fileOf(size_t offset) const
+{
+    return std::lower_bound(itsEofs.begin(), itsEofs.end(), offset) -
+           itsEofs.begin();
+}
@@ -0,0 +1,66 @@
+#ifndef GAP_CHAINER_HH
+#define GAP_CHAINER_HH
+
+#include <cstdlib> // size_t
+#include <vector>
+
+class BookmarkContainer;
+
+/**
+ * Chains exact duplications that are close to each other, in the same order
+ * in both places, into one duplication with gaps. An edited line then doesn't
+ * split a duplicated function into two shorter duplications.
+ *
+ * The exact matches are found among the pairs of neighbors in sorted order.
+ * Pairs on the same diagonal, i.e., with the same distance between the two
+ * instances, are merged where they overlap. The matches are then visited in
+ * text order, and each one continues the chain with the most matched
+ * characters that ends at most maxGap characters before it in both
+ * instances. The diagonals of two such matches differ by at most maxGap, so
+ * the chains are looked up by diagonal, which takes O(n log n) time for n
+ * pairs rather than comparing all pairs of matches.
+ */
+class GapChainer
+{
+public:
+    struct Clone
+    {
+        size_t firstIx;      // Sorted index of the bookmark at each
+        size_t secondIx;     // instance.
+        size_t firstLength;  // Characters from the start of the first match
+        size_t secondLength; // to the end of the last one.
+    };
+
+    // The container must be sorted all the way.
+    GapChainer(const BookmarkContainer& container, size_t maxGap);
+
+    // Shorter exact matches are mostly coincidental and are not chained.
+    static const size_t MIN_MATCH_LENGTH = 10;
+
+    /**
+     * Returns the clones whose first instance is at least minLength
+     * characters long, longest first. A clone is left out if both of its
+     * instances are within instances of longer clones.
+     */
+    std::vector<Clone> clones(size_t minLength) const;
+
+private:
+    struct Match
+    {
+        size_t first;    // Offsets of the two instances, first < second.
+        size_t second;
+        size_t length;
+        size_t firstIx;
+        size_t secondIx;
+    };
+
+    std::vector<Match> findMatches() const;
+    size_t             fileOf(size_t offset) const;
+
+    const BookmarkContainer& itsContainer;
+    const size_t             itsMaxGap;
+    std::vector<size_t>      itsEofs; // Offsets of the ends of the files.
+    std::vector<Clone>       itsClones;
+};
+
+#endif
@@ -0,0 +1,397 @@
+#include "index_file.hh"
+#include "bookmark.hh"
+#include "bookmark_container.hh"
+#include "compare.hh" // COMPARE_PADDING
+#include "file.hh"    // SPECIAL_EOF
+
+#include <algorithm>  // any_of, count, min
+#include <cstdint>
+#include <cstdio>     // fopen, fread, fwrite, rename
+#include <cstdlib>    // exit
+#include <cstddef>    // ptrdiff_t
+#include <cstring>    // memchr, memcmp, memcpy, strlen
+#include <fcntl.h>    // open
+#include <iostream>   // cerr
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat, mkdir, stat
+#include <unistd.h>   // close
+#include <vector>
+
+// Changed whenever the format of the file changes.
+static const char     MAGIC[16]  = "dupfind index\n";
+static const uint64_t VERSION    = 4;
+static const uint64_t ENDIANNESS = 0x0102030405060708ULL;
+
+static const char* const FILE_NAME = "/dupfind.index";
+
+// The numbers are written this many at a time.
+static const size_t CHUNK_SIZE = 4096;
+
+namespace
+{
+    struct Header
+    {
+        char     magic[16];
+        uint64_t version;
+        uint64_t byteOrder;       // Tells if the machine is the same kind.
+        uint64_t width;           // Of each number in the arrays.
+        uint64_t wordMode;
+        uint64_t nrOfFiles;
+        uint64_t originalLength;
+        uint64_t processedLength; // With the terminating null character.
+        uint64_t nrOfMarks;
+        uint64_t nrOfBookmarks;
+        uint64_t markDueAtEnd;    // After the last file.
+        int64_t  readTime;        // When the files began to be read.
+    };
+
+    // A file that is read section by section, checking that it's there.
+    class Input
+    {
+    public:
+        Input(const char* data, size_t size, const std::string& path):
+            itsData(data), itsSize(size), itsPosition(0), itsPath(path) {}
+
+        const char* take(size_t length);
+        uint64_t    number();
+        void        numbers(size_t        count,
+                            size_t        width,
+                            size_t        limit,
+                            OffsetVector& result);
+        void        fail() const;
+
+    private:
+        const char*       itsData;
+        const size_t      itsSize;
+        size_t            itsPosition;
+        const std::string itsPath;
+    };
+}
+
+// The number of zero bytes after a section of the given length.
+static size_t padding(size_t length)
+{
+    return (8 - length % 8) % 8;
+}
+
+static bool writeBytes(FILE* file, const void* bytes, size_t length)
+{
+    static const char zeroes[8] = {};
+    return fwrite(bytes, 1, length, file) == length &&
+        fwrite(zeroes, 1, padding(length), file) == padding(length);
+}
+
+static bool writeNumber(FILE* file, uint64_t number)
+{
+    return fwrite(&number, sizeof number, 1, file) == 1;
+}
+
+// Writes the numbers that get() gives for the indexes up to count.
+template <typename Get>
+static bool writeNumbers(FILE* file, size_t count, size_t width, Get get)
+{
+    std::vector<char> chunk;
+    for (size_t begin = 0; begin < count; begin += CHUNK_SIZE)
+    {
+        const size_t end = std::min(begin + CHUNK_SIZE, count);
+        chunk.resize((end - begin) * width);
+        for (size_t i = begin; i < end; ++i)
+        {
+            const uint64_t wide   = get(i);
+            const uint32_t narrow = uint32_t(wide);
+            std::memcpy(&chunk[(i - begin) * width],
+                        (width == 4) ? static_cast<const void*>(&narrow) :
+                                       static_cast<const void*>(&wide),
+                        width);
+        }
+        if (fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size())
+            return false;
+    }
+    static const char zeroes[8] = {};
+    return fwrite(zeroes, 1, padding(count * width), file) ==
+        padding(count * width);
+}
+
+IndexFile::IndexFile(const std::string& directory):
+    itsDirectory(directory),
+    itsPath(directory + FILE_NAME)
+{
+}
+
+/**
+ * Writes to a temporary file in the directory and renames it, so that an
+ * index that is being searched is never half written.
+ */
+void IndexFile::write(const BookmarkContainer& container,
+                      bool                     wordMode,
+                      const std::vector<bool>& marksDue,
+                      int64_t                  readTime) const
+{
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof MAGIC);
+    header.version         = VERSION;
+    header.byteOrder       = ENDIANNESS;
+    header.wordMode        = wordMode;
+    header.nrOfFiles       = Bookmark::nrOfFiles();
+    header.originalLength  = Bookmark::totalLength();
+    header.processedLength = std::strlen(container.text()) + 1;
+    header.nrOfMarks       = container.itsMarkOffsets.size();
+    header.nrOfBookmarks   = container.size();
+    header.markDueAtEnd    = marksDue.back();
+    header.readTime        = readTime;
+    header.width           =
+        (header.originalLength <= UINT32_MAX &&
+         header.processedLength <= UINT32_MAX) ? 4 : 8;
+
+    mkdir(itsDirectory.c_str(), 0777);
+    const std::string temporary = itsPath + ".tmp";
+    FILE*             file      = fopen(temporary.c_str(), "wb");
+    bool              isOk      = file != 0 &&
+        fwrite(&header, sizeof header, 1, file) == 1;
+    for (size_t f = 0; isOk && f < Bookmark::nrOfFiles(); ++f)
+    {
+        const std::string& name = Bookmark::fileName(f);
+        isOk = writeNumber(file, Bookmark::fileEnd(f)) &&
+            writeNumber(file, Bookmark::setOf(f)) &&
+            writeNumber(file, marksDue[f]) &&
+            writeNumber(file, name.size()) &&
+            writeBytes(file, name.data(), name.size());
+    }
+    // The numbers of common characters and the sparse table over them are
+    // read back as they are, so that the table needn't be built again. If
+    // the bookmarks were sorted in runs on disk, there's no table yet.
+    LcpTable   built;
+    const bool hasTable = container.hasLcpTable() &&
+        container.itsLcpTable.itsSame.size() + 1 == container.size();
+    if (not hasTable)
+    {
+        for (size_t ix = 0; ix + 1 < container.size(); ++ix)
+            built.add(container.nrOfSame(ix, ix + 1));
+        built.build();
+    }
+    const LcpTable& table = hasTable ? container.itsLcpTable : built;
+
+    const size_t width = header.width;
+    isOk = isOk &&
+        writeBytes(file, Bookmark::theirOriginalString.data(),
+                   header.originalLength) &&
+        writeBytes(file, container.text(), header.processedLength) &&
+        writeNumbers(file, header.nrOfMarks, width, [&](size_t i) {
+            return container.itsMarkOffsets[i];
+        }) &&
+        writeNumbers(file, header.nrOfMarks, width, [&](size_t i) {
+            return container.itsMarkOriginals[i];
+        }) &&
+        writeNumbers(file, header.nrOfBookmarks, width, [&](size_t ix) {
+            return container.offset(ix);
+        }) &&
+        writeNumbers(file, table.itsSame.size(), width, [&](size_t ix) {
+            return table.itsSame[ix];
+        });
+    for (size_t k = 0; isOk && k < table.itsLevels.size(); ++k)
+        isOk = writeNumbers(file, table.itsLevels[k].size(), width,
+                            [&](size_t i) { return table.itsLevels[k][i]; });
+    if (file != 0 && fclose(file) != 0)
+        isOk = false;
+    if (not isOk || rename(temporary.c_str(), itsPath.c_str()) != 0)
+    {
+        remove(temporary.c_str());
+        std::cerr << "dupfind: Could not write the index " << itsPath
+                  << ".\n";
+        exit(EXIT_FAILURE);
+    }
+}
+
+const char* IndexFile::read(BookmarkContainer& container,
+                            bool               wordMode,
+                            std::vector<bool>& marksDue) const
+{
+    const int   fd = open(itsPath.c_str(), O_RDONLY);
+    struct stat s;
+    if (fd < 0 || fstat(fd, &s) != 0)
+    {
+        std::cerr << "dupfind: Index " << itsPath << " not found.\n";
+        exit(EXIT_FAILURE);
+    }
+    const size_t size = s.st_size;
+    void* const  data = (size > 0) ?
+        mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    Input input(static_cast<const char*>(data), size, itsPath);
+    if (data == MAP_FAILED)
+        input.fail();
+
+    Header header;
+    std::memcpy(&header, input.take(sizeof header), sizeof header);
+    if (std::memcmp(header.magic, MAGIC, sizeof MAGIC) != 0 ||
+        header.version != VERSION || header.byteOrder != ENDIANNESS ||
+        (header.width != 4 && header.width != 8) ||
+        header.processedLength == 0)
+    {
+        input.fail();
+    }
+    if (bool(header.wordMode) != wordMode)
+    {
+        std::cerr << "dupfind: The index " << itsPath << " was built "
+                  << (header.wordMode ? "with -w, which must be given with "
+                                        "it too.\n" :
+                                        "without -w, which can't be given "
+                                        "with it.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t previousEnd = 0;
+    for (size_t f = 0; f < header.nrOfFiles; ++f)
+    {
+        const size_t end = input.number();
+        const size_t set        = input.number();
+        marksDue.push_back(input.number() != 0);
+        const size_t nameLength = input.number();
+        if (end <= previousEnd || end > header.originalLength ||
+            set > Bookmark::RIGHT_SET)
+        {
+            input.fail();
+        }
+        Bookmark::theirFileRecords.push_back(Bookmark::FileRecord(
+            std::string(input.take(nameLength), nameLength), end,
+            Bookmark::FileSet(set)));
+        previousEnd = end;
+    }
+    if (previousEnd != header.originalLength)
+        input.fail();
+    marksDue.push_back(header.markDueAtEnd != 0);
+    Bookmark::theirOriginalString.assign(input.take(header.originalLength),
+                                         header.originalLength);
+
+    // Leave room for the vectorized comparisons, just like the parser. The
+    // text must end where its files do.
+    const char* processed = input.take(header.processedLength);
+    if (std::memchr(processed, '\0', header.processedLength) !=
+        processed + header.processedLength - 1 ||
+        std::count(processed, processed + header.processedLength,
+                   SPECIAL_EOF) != ptrdiff_t(header.nrOfFiles))
+    {
+        input.fail();
+    }
+    char* const text = new char[header.processedLength + COMPARE_PADDING]();
+    std::memcpy(text, processed, header.processedLength);
+    container.setText(text);
+
+    const size_t width = header.width;
+    input.numbers(header.nrOfMarks, width, header.processedLength,
+                  container.itsMarkOffsets);
+    input.numbers(header.nrOfMarks, width, header.originalLength,
+                  container.itsMarkOriginals);
+    input.numbers(header.nrOfBookmarks, width, header.processedLength,
+                  container.itsOffsets);
+    LcpTable&    table     = container.itsLcpTable;
+    const size_t nrOfPairs =
+        (header.nrOfBookmarks > 0) ? header.nrOfBookmarks - 1 : 0;
+    table = LcpTable();
+    input.numbers(nrOfPairs, width, header.processedLength, table.itsSame);
+    const std::vector<size_t> levelSizes = LcpTable::levelSizes(nrOfPairs);
+    table.itsLevels.resize(levelSizes.size());
+    for (size_t k = 0; k < levelSizes.size(); ++k)
+        input.numbers(levelSizes[k], width, header.processedLength,
+                      table.itsLevels[k]);
+    munmap(data, size);
+
+    // The bookmarks must be in order in both texts, and the sorted ones must
+    // be the same bookmarks, each once, or looking up the original index of
+    // a sorted one would read out of range. A bookmark is crossed off the
+    // text when it's found among the sorted ones.
+    const OffsetVector& markOffsets   = container.itsMarkOffsets;
+    const OffsetVector& markOriginals = container.itsMarkOriginals;
+    std::vector<bool>   isUnsorted(header.processedLength, false);
+    for (size_t m = 0; m < markOffsets.size(); ++m)
+    {
+        if (m > 0 && (markOffsets[m] <= markOffsets[m - 1] ||
+                      markOriginals[m] <= markOriginals[m - 1]))
+        {
+            input.fail();
+        }
+        isUnsorted[markOffsets[m]] = true;
+    }
+    for (size_t ix = 0; ix < container.itsOffsets.size(); ++ix)
+    {
+        const size_t offset = container.itsOffsets[ix];
+        if (not isUnsorted[offset])
+            input.fail();
+        isUnsorted[offset] = false;
+    }
+
+    container.itsRanks.assignIndexes(container.itsOffsets.size());
+    container.itsSortDepth = SIZE_MAX;
+    return text;
+}
+
+int64_t IndexFile::readTime() const
+{
+    Header     header;
+    FILE*      file = fopen(itsPath.c_str(), "rb");
+    const bool isOk = file != 0 &&
+        fread(&header, sizeof header, 1, file) == 1 &&
+        std::memcmp(header.magic, MAGIC, sizeof MAGIC) == 0 &&
+        header.version == VERSION && header.byteOrder == ENDIANNESS;
+    if (file != 0)
+        fclose(file);
+    return isOk ? header.readTime : -1;
+}
+
+// Returns the next section, which must be in the file.
+const char* Input::take(size_t length)
+{
+    if (itsPosition > itsSize || length > itsSize - itsPosition)
+        fail();
+    const char* section = itsData + itsPosition;
+    itsPosition += length + padding(length);
+    return section;
+}
+
+uint64_t Input::number()
+{
+    uint64_t number;
+    std::memcpy(&number, take(sizeof number), sizeof number);
+    return number;
+}
+
+// Puts the numbers of a section in the result, unless one of them is not
+// below the limit.
+template <typename Number>
+static bool assignBelow(const char*   section,
+                        size_t        count,
+                        size_t        limit,
+                        OffsetVector& result)
+{
+    const Number* const first = reinterpret_cast<const Number*>(section);
+    const Number* const last  = first + count;
+    if (std::any_of(first, last, [&](Number n) { return n >= limit; }))
+        return false;
+    result.assign(first, last);
+    return true;
+}
+
+// Reads numbers that must all be below the limit. The sections of the mapped
+// file begin at multiples of eight bytes, so the numbers are aligned.
+void Input::numbers(size_t        count,
+                    size_t        width,
+                    size_t        limit,
+                    OffsetVector& result)
+{
+    if (count > SIZE_MAX / width)
+        fail();
+    const char* section = take(count * width);
+    if (not ((width == 4) ?
+             assignBelow<uint32_t>(section, count, limit, result) :
+             assignBelow<uint64_t>(section, count, limit, result)))
+    {
+        fail();
+    }
+}
+
+void Input::fail() const
+{
+    std::cerr << "dupfind: " << itsPath << " is not an index of this "
+              << "version of dupfind.\n";
+    exit(EXIT_FAILURE);
+}
@@ -0,0 +1,61 @@
+#ifndef INDEX_FILE_HH
+#define INDEX_FILE_HH
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class BookmarkContainer;
+
+/**
+ * An index of files that have been parsed and sorted, kept in a directory so
+ * that they can be searched again and again without doing that each time.
+ * It holds the names of the files, their original and processed text, the
+ * bookmarks in text order and in sorted order, and the number of characters
+ * that sorted neighbors have in common, with the sparse table of an LcpTable
+ * over them. Everything is read back as it is, without sorting or building
+ * anything again.
+ *
+ * Every section of the file begins at a multiple of eight bytes, and the
+ * numbers are stored with four bytes if all offsets fit, or else eight, in
+ * the byte order of the machine. The file is mapped into memory when it's
+ * read.
+ */
+class IndexFile
+{
+public:
+    explicit IndexFile(const std::string& directory);
+
+    /**
+     * Writes the files and the bookmarks, which must be sorted all the way
+     * with an LcpTable, and whether a bookmark was due at the beginning of
+     * each file and at the end of the last one, and when the files began to
+     * be read, in seconds since the epoch. The directory is created if it
+     * doesn't exist.
+     */
+    void write(const BookmarkContainer& container,
+               bool                     wordMode,
+               const std::vector<bool>& marksDue,
+               int64_t                  readTime) const;
+
+    /**
+     * Reads the files and sorted bookmarks into an empty container, and
+     * tells where bookmarks were due. The files must have been parsed as
+     * words if and only if wordMode is set. Returns the processed text, which
+     * the caller must delete.
+     */
+    const char* read(BookmarkContainer& container,
+                     bool               wordMode,
+                     std::vector<bool>& marksDue) const;
+
+    // When the files in the index began to be read, in seconds since the
+    // epoch, or -1 if the index can't be read. A file that was changed
+    // earlier has the same text in the index.
+    int64_t readTime() const;
+
+private:
+    const std::string itsDirectory;
+    const std::string itsPath;
+};
+
+#endif
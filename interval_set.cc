@@ -0,0 +1,35 @@
+#include "interval_set.hh"
+
+#include <algorithm> // max
+#include <iterator>  // prev
+
+bool IntervalSet::contains(size_t begin, size_t end) const
+{
+    const auto after = itsIntervals.upper_bound(begin);
+    return after != itsIntervals.begin() && std::prev(after)->second >= end;
+}
+
+size_t IntervalSet::endFrom(size_t position) const
+{
+    const auto after = itsIntervals.upper_bound(position);
+    if (after == itsIntervals.begin() || std::prev(after)->second <= position)
+        return position;
+    return std::prev(after)->second;
+}
+
+void IntervalSet::insert(size_t begin, size_t end)
+{
+    // Intervals that overlap or touch the new one are merged with it.
+    auto it = itsIntervals.upper_bound(begin);
+    if (it != itsIntervals.begin() && std::prev(it)->second >= begin)
+    {
+        --it;
+        begin = it->first;
+    }
+    while (it != itsIntervals.end() && it->first <= end)
+    {
+        end = std::max(end, it->second);
+        it  = itsIntervals.erase(it);
+    }
+    itsIntervals[begin] = end;
+}
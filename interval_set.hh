@@ -0,0 +1,27 @@
+#ifndef INTERVAL_SET_HH
+#define INTERVAL_SET_HH
+
+#include <cstdlib> // size_t
+#include <map>
+
+/**
+ * A set of positions, kept as disjoint intervals, e.g. the parts of the text
+ * that have been reported already.
+ */
+class IntervalSet
+{
+public:
+    // Are all positions from begin up to end in the set?
+    bool contains(size_t begin, size_t end) const;
+
+    void insert(size_t begin, size_t end);
+
+    // Where the interval that holds the position ends, or the position itself
+    // if it's not in the set.
+    size_t endFrom(size_t position) const;
+
+private:
+    std::map<size_t, size_t> itsIntervals; // From the begin to the end.
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "lcp_table.hh"
+
+#include <algorithm> // min
+
+void LcpTable::build()
+{
+    const std::vector<size_t> sizes = levelSizes(itsSame.size());
+    itsLevels.assign(sizes.size(), OffsetVector());
+    for (size_t begin = 0; begin < itsSame.size(); begin += BLOCK_SIZE)
+    {
+        const size_t end = std::min(begin + BLOCK_SIZE, itsSame.size());
+        size_t       min = itsSame[begin];
+        for (size_t i = begin + 1; i < end; ++i)
+            min = std::min(min, itsSame[i]);
+        itsLevels[0].push_back(min);
+    }
+
+    for (size_t k = 1; k < sizes.size(); ++k)
+    {
+        const size_t        half  = size_t(1) << (k - 1);
+        const OffsetVector& below = itsLevels[k - 1];
+        OffsetVector&       level = itsLevels[k];
+        for (size_t i = 0; i < sizes[k]; ++i)
+            level.push_back(std::min(below[i], below[i + half]));
+    }
+}
+
+std::vector<size_t> LcpTable::levelSizes(size_t nrOfPairs)
+{
+    // Level k has a number for each whole range of 2^k blocks.
+    std::vector<size_t> sizes(1, (nrOfPairs + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    for (size_t k = 1; (size_t(1) << k) <= sizes[0]; ++k)
+        sizes.push_back(sizes[0] - (size_t(1) << k) + 1);
+    return sizes;
+}
+
+// Returns the smallest number for the blocks from begin up to end.
+size_t LcpTable::blockMinimum(size_t begin, size_t end) const
+{
+    const size_t k = 63 - __builtin_clzll(end - begin);
+    return std::min(itsLevels[k][begin], itsLevels[k][end - (size_t(1) << k)]);
+}
+
+size_t LcpTable::minimum(size_t begin, size_t end) const
+{
+    const size_t firstBlock = (begin + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t endBlock   = end / BLOCK_SIZE;
+    if (firstBlock >= endBlock)
+    {
+        size_t min = itsSame[begin];
+        for (size_t i = begin + 1; i < end; ++i)
+            min = std::min(min, itsSame[i]);
+        return min;
+    }
+
+    size_t min = blockMinimum(firstBlock, endBlock);
+    for (size_t i = begin; i < firstBlock * BLOCK_SIZE; ++i)
+        min = std::min(min, itsSame[i]);
+    for (size_t i = endBlock * BLOCK_SIZE; i < end; ++i)
+        min = std::min(min, itsSame[i]);
+    return min;
+}
+
+size_t LcpTable::firstWithSame(size_t ix, size_t same) const
+{
+    // Step to the start of the block, then take the longest possible step
+    // over whole blocks at each level from the top down, and finally step
+    // through the block where the number gets too small.
+    size_t first = ix;
+    while (first % BLOCK_SIZE != 0 && itsSame[first - 1] >= same)
+        --first;
+    if (first % BLOCK_SIZE != 0)
+        return first;
+
+    size_t block = first / BLOCK_SIZE;
+    for (size_t k = itsLevels.size(); k-- > 0;)
+    {
+        const size_t step = size_t(1) << k;
+        if (block >= step && itsLevels[k][block - step] >= same)
+            block -= step;
+    }
+    first = block * BLOCK_SIZE;
+    while (first > 0 && itsSame[first - 1] >= same)
+        --first;
+    return first;
+}
+
+size_t LcpTable::lastWithSame(size_t ix, size_t same) const
+{
+    const size_t nrOfPairs = itsSame.size();
+    size_t       last      = ix;
+    while (last % BLOCK_SIZE != 0 && last < nrOfPairs &&
+           itsSame[last] >= same)
+    {
+        ++last;
+    }
+    if (last % BLOCK_SIZE != 0 || last >= nrOfPairs)
+        return last;
+
+    size_t block = last / BLOCK_SIZE;
+    for (size_t k = itsLevels.size(); k-- > 0;)
+        if (block < itsLevels[k].size() && itsLevels[k][block] >= same)
+            block += size_t(1) << k;
+    last = std::min(block * BLOCK_SIZE, nrOfPairs);
+    while (last < nrOfPairs && itsSame[last] >= same)
+        ++last;
+    return last;
+}
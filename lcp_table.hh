@@ -0,0 +1,68 @@
+#ifndef LCP_TABLE_HH
+#define LCP_TABLE_HH
+
+#include <vector>
+
+#include "offset_vector.hh"
+
+/**
+ * Keeps the number of common characters of each pair of neighbors among the
+ * sorted bookmarks. Since the bookmarks are sorted, the number of common
+ * characters of any two of them is the smallest number for the pairs in
+ * between, which the table gives in constant time.
+ *
+ * The pairs are grouped into blocks, and a sparse table holds the smallest
+ * number in each range of 2^k blocks on level k. A query looks up the whole
+ * blocks in the sparse table and goes through the pairs at the ends one by
+ * one. This needs far less memory than a sparse table over all pairs.
+ */
+class LcpTable
+{
+public:
+    bool empty() const { return itsSame.size() == 0; }
+
+    /**
+     * Adds the number of common characters of the next pair of neighbors.
+     * All pairs must be added before build() is called.
+     */
+    void add(size_t same) { itsSame.push_back(same); }
+
+    void build();
+
+    /**
+     * Returns the number of blocks on each level of the sparse table that
+     * build() makes for the given number of pairs.
+     */
+    static std::vector<size_t> levelSizes(size_t nrOfPairs);
+
+    /**
+     * Returns the smallest number of common characters for the pairs from
+     * begin up to, but not including, end. Pair i is the bookmarks with
+     * sorted index i and i + 1.
+     */
+    size_t minimum(size_t begin, size_t end) const;
+
+    /**
+     * Returns the smallest index of a bookmark that has at least the given
+     * number of characters in common with the bookmark at index ix.
+     */
+    size_t firstWithSame(size_t ix, size_t same) const;
+
+    /**
+     * Returns the largest index of a bookmark that has at least the given
+     * number of characters in common with the bookmark at index ix.
+     */
+    size_t lastWithSame(size_t ix, size_t same) const;
+
+private:
+    friend class IndexFile;
+
+    static const size_t BLOCK_SIZE = 16;
+
+    size_t blockMinimum(size_t begin, size_t end) const;
+
+    OffsetVector              itsSame;   // One number per pair.
+    std::vector<OffsetVector> itsLevels; // The sparse table over blocks.
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include "min_hasher.hh"
+#include "file.hh" // SPECIAL_EOF
+
+#include <algorithm> // sort, unique
+#include <cmath>     // pow
+#include <cstring>   // strchr
+#include <utility>   // pair
+
+// For the rolling hash of the shingles and the hash of the bands.
+static const uint64_t HASH_BASE = 0x100000001b3ULL;
+
+// Added for each bin that an empty bin borrows across, so that the bins of
+// small files don't look alike just because they borrow from each other.
+static const uint64_t BORROW_OFFSET = 0x9e3779b97f4a7c15ULL;
+
+// Files that are as alike as the threshold become candidates with at least
+// this probability.
+static const double MIN_CANDIDATE_PROBABILITY = 0.99;
+
+// Spreads the bits of a rolling hash, whose low bits depend on the last
+// characters only. This is the finalizer of SplitMix64.
+static uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+MinHasher::MinHasher(const char* processedText): itsNrOfCandidates(0)
+{
+    const char* begin = processedText;
+    for (const char* eof = strchr(processedText, SPECIAL_EOF); eof != 0;
+         eof = strchr(eof + 1, SPECIAL_EOF))
+    {
+        itsSignatures.push_back(Signature());
+        signatureOf(begin, eof, itsSignatures.back());
+        begin = eof + 1;
+    }
+}
+
+std::vector<MinHasher::SimilarPair> MinHasher::similarPairs(double threshold)
+{
+    // A pair becomes a candidate if all rows of some band are the same, so
+    // fewer rows per band catch less similar pairs but give more candidates.
+    size_t rows = NR_OF_BINS;
+    while (rows > 1 &&
+           1 - std::pow(1 - std::pow(threshold, rows), NR_OF_BINS / rows) <
+               MIN_CANDIDATE_PROBABILITY)
+    {
+        rows /= 2;
+    }
+
+    // The pairs of files are kept as first << 32 | second.
+    std::vector<uint64_t>                     candidates;
+    std::vector<std::pair<uint64_t, size_t> > keys;
+    for (size_t band = 0; band < NR_OF_BINS / rows; ++band)
+    {
+        keys.clear();
+        for (size_t file = 0; file < itsSignatures.size(); ++file)
+        {
+            if (itsSignatures[file].empty())
+                continue;
+            uint64_t key = 0;
+            for (size_t bin = band * rows; bin < (band + 1) * rows; ++bin)
+                key = key * HASH_BASE + itsSignatures[file][bin];
+            keys.push_back(std::make_pair(key, file));
+        }
+        std::sort(keys.begin(), keys.end());
+        for (size_t begin = 0; begin < keys.size();)
+        {
+            size_t end = begin + 1;
+            while (end < keys.size() && keys[end].first == keys[begin].first)
+                ++end;
+            for (size_t a = begin; a < end; ++a)
+                for (size_t b = a + 1; b < end; ++b)
+                    candidates.push_back(uint64_t(keys[a].second) << 32 |
+                                         keys[b].second);
+            begin = end;
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+    itsNrOfCandidates = candidates.size();
+
+    std::vector<SimilarPair> result;
+    for (size_t c = 0; c < candidates.size(); ++c)
+    {
+        SimilarPair pair;
+        pair.first  = candidates[c] >> 32;
+        pair.second = candidates[c] & 0xffffffff;
+        size_t nrOfSame = 0;
+        for (size_t bin = 0; bin < NR_OF_BINS; ++bin)
+            if (itsSignatures[pair.first][bin] ==
+                itsSignatures[pair.second][bin])
+            {
+                ++nrOfSame;
+            }
+        pair.similarity = double(nrOfSame) / NR_OF_BINS;
+        if (pair.similarity >= threshold)
+            result.push_back(pair);
+    }
+    std::stable_sort(result.begin(), result.end(),
+                     [](const SimilarPair& a, const SimilarPair& b) {
+                         return a.similarity > b.similarity;
+                     });
+    return result;
+}
+
+/**
+ * Makes the signature of the text from begin up to end. Returns false, and
+ * leaves the signature empty, if the text is shorter than a shingle.
+ */
+bool MinHasher::signatureOf(const char* begin,
+                            const char* end,
+                            Signature&  signature)
+{
+    if (size_t(end - begin) < SHINGLE_LENGTH)
+        return false;
+    uint64_t power = 1; // Of the first character in the shingle.
+    for (size_t i = 0; i < SHINGLE_LENGTH; ++i)
+        power *= HASH_BASE;
+
+    std::vector<uint64_t> mins(NR_OF_BINS, UINT64_MAX);
+    uint64_t              hash = 0;
+    for (const char* p = begin; p < end; ++p)
+    {
+        hash = hash * HASH_BASE + (unsigned char)*p;
+        if (size_t(p - begin) >= SHINGLE_LENGTH)
+            hash -= (unsigned char)*(p - SHINGLE_LENGTH) * power;
+        if (size_t(p + 1 - begin) >= SHINGLE_LENGTH)
+        {
+            const uint64_t h   = mix(hash);
+            uint64_t&      min = mins[h % NR_OF_BINS];
+            if (h < min)
+                min = h;
+        }
+    }
+
+    signature.resize(NR_OF_BINS);
+    for (size_t bin = 0; bin < NR_OF_BINS; ++bin)
+    {
+        size_t distance = 0;
+        while (mins[(bin + distance) % NR_OF_BINS] == UINT64_MAX)
+            ++distance;
+        const uint64_t value =
+            mins[(bin + distance) % NR_OF_BINS] + distance * BORROW_OFFSET;
+        signature[bin] = uint32_t(value ^ (value >> 32));
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef MIN_HASHER_HH
+#define MIN_HASHER_HH
+
+#include <cstdint>
+#include <cstdlib> // size_t
+#include <vector>
+
+/**
+ * Finds pairs of files whose processed texts are alike as a whole, e.g.,
+ * files that were copied and then edited a bit, without comparing all pairs
+ * of files.
+ *
+ * Each file is seen as the set of its shingles, i.e., the runs of
+ * SHINGLE_LENGTH characters within it, and gets a MinHash signature, from
+ * which the Jaccard similarity of two such sets can be estimated. The
+ * signature is made with one permutation: the hash of each shingle selects a
+ * bin, which keeps the smallest hash it gets, and empty bins borrow from the
+ * next bin that isn't. That takes one pass over the text. The signatures are
+ * then split into bands, and only files that have all bins of some band in
+ * common become candidates. The number of bands is chosen so that files as
+ * alike as the threshold almost surely do.
+ */
+class MinHasher
+{
+public:
+    struct SimilarPair
+    {
+        size_t first;      // File numbers, first < second.
+        size_t second;
+        double similarity; // Estimated Jaccard similarity.
+    };
+
+    // The text holds the processed files, each ended by SPECIAL_EOF.
+    explicit MinHasher(const char* processedText);
+
+    static const size_t SHINGLE_LENGTH = 16;
+    static const size_t NR_OF_BINS     = 128;
+
+    size_t nrOfCandidates() const { return itsNrOfCandidates; }
+
+    /**
+     * Returns the pairs of files whose estimated similarity is at least the
+     * threshold, most similar first.
+     */
+    std::vector<SimilarPair> similarPairs(double threshold);
+
+private:
+    typedef std::vector<uint32_t> Signature;
+
+    static bool signatureOf(const char* begin,
+                            const char* end,
+                            Signature&  signature);
+
+    std::vector<Signature> itsSignatures; // Empty for files without shingles.
+    size_t                 itsNrOfCandidates;
+};
+
+#endif
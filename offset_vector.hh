@@ -0,0 +1,148 @@
+#ifndef OFFSET_VECTOR_HH
+#define OFFSET_VECTOR_HH
+
+#include <algorithm> // any_of, lower_bound, upper_bound
+#include <cstdint>
+#include <numeric>   // iota
+#include <vector>
+
+// Offsets up to this value are stored with 32 bits. It can be lowered at
+// compile time to run the 64-bit code paths on small input.
+#ifndef OFFSET_NARROW_LIMIT
+#define OFFSET_NARROW_LIMIT 0xffffffffULL
+#endif
+
+/**
+ * A vector of offsets into a text. The offsets are stored with 32 bits as
+ * long as they fit, which halves the memory they need and makes sorting more
+ * cache friendly. The first time a bigger offset is added, all offsets are
+ * converted to 64 bits.
+ *
+ * Loops where speed matters can work directly on the underlying vector with
+ * narrow() or wide(), depending on isWide().
+ */
+class OffsetVector
+{
+public:
+    OffsetVector(): itsIsWide(false) {}
+
+    bool isWide() const { return itsIsWide; }
+
+    size_t size() const
+    {
+        return itsIsWide ? itsWide.size() : itsNarrow.size();
+    }
+
+    size_t operator[](size_t ix) const
+    {
+        return itsIsWide ? itsWide[ix] : itsNarrow[ix];
+    }
+
+    /**
+     * Sets an element to a value that is already in the vector, so no
+     * conversion to 64 bits is needed.
+     */
+    void set(size_t ix, size_t value)
+    {
+        if (itsIsWide)
+            itsWide[ix] = value;
+        else
+            itsNarrow[ix] = value;
+    }
+
+    void push_back(size_t value)
+    {
+        if (not itsIsWide && value > OFFSET_NARROW_LIMIT)
+            widen();
+        if (itsIsWide)
+            itsWide.push_back(value);
+        else
+            itsNarrow.push_back(value);
+    }
+
+    /**
+     * Replaces the elements with those in the range, which are kept with 32
+     * bits if they are 32-bit numbers.
+     */
+    void assign(const uint32_t* first, const uint32_t* last)
+    {
+        std::vector<uint64_t>().swap(itsWide);
+        itsNarrow.assign(first, last);
+        itsIsWide = false;
+        if (std::any_of(first, last,
+                        [](uint64_t v) { return v > OFFSET_NARROW_LIMIT; }))
+        {
+            widen();
+        }
+    }
+
+    void assign(const uint64_t* first, const uint64_t* last)
+    {
+        std::vector<uint32_t>().swap(itsNarrow);
+        itsWide.assign(first, last);
+        itsIsWide = true;
+    }
+
+    // Replaces the elements with the indexes from 0 up to n.
+    void assignIndexes(size_t n)
+    {
+        itsIsWide = n > 0 && n - 1 > OFFSET_NARROW_LIMIT;
+        if (itsIsWide)
+        {
+            std::vector<uint32_t>().swap(itsNarrow);
+            itsWide.resize(n);
+            std::iota(itsWide.begin(), itsWide.end(), uint64_t(0));
+        }
+        else
+        {
+            std::vector<uint64_t>().swap(itsWide);
+            itsNarrow.resize(n);
+            std::iota(itsNarrow.begin(), itsNarrow.end(), uint32_t(0));
+        }
+    }
+
+    // Returns the index of the first element that is not less than the value.
+    size_t lowerBound(size_t value) const
+    {
+        return itsIsWide ?
+            std::lower_bound(itsWide.begin(), itsWide.end(), value) -
+            itsWide.begin() :
+            std::lower_bound(itsNarrow.begin(), itsNarrow.end(), value) -
+            itsNarrow.begin();
+    }
+
+    // Returns the index of the first element that is greater than the value.
+    size_t upperBound(size_t value) const
+    {
+        return itsIsWide ?
+            std::upper_bound(itsWide.begin(), itsWide.end(), value) -
+            itsWide.begin() :
+            std::upper_bound(itsNarrow.begin(), itsNarrow.end(), value) -
+            itsNarrow.begin();
+    }
+
+    void resize(size_t n)
+    {
+        if (itsIsWide)
+            itsWide.resize(n);
+        else
+            itsNarrow.resize(n);
+    }
+
+    std::vector<uint32_t>& narrow() { return itsNarrow; }
+    std::vector<uint64_t>& wide()   { return itsWide; }
+
+private:
+    void widen()
+    {
+        itsWide.assign(itsNarrow.begin(), itsNarrow.end());
+        std::vector<uint32_t>().swap(itsNarrow);
+        itsIsWide = true;
+    }
+
+    bool                  itsIsWide;
+    std::vector<uint32_t> itsNarrow;
+    std::vector<uint64_t> itsWide;
+};
+
+#endif
@@ -5,10 +5,12 @@
 #include <iostream>   // ostream, cout, cerr, endl
 #include <cstring>    // strcmp, strncmp, strlen
 #include <climits>    // INT_MAX
+#include <cstdint>    // SIZE_MAX
 #include <sys/stat.h> // struct stat
 #include <string>
 #include <vector>
 #include <dirent.h>   // DIR, opendir(), readdir(), closedir()
+#include <thread>     // hardware_concurrency
 
 using std::cerr;
 using std::endl;
@@ -20,8 +22,25 @@ Options::Options(): nrOfWantedReports(5),
                     totalReport(NO_TOTAL),
                     minLength(10),
                     proximityFactor(90),
-                    wordMode(false)
+                    wordMode(false),
+                    nrOfThreads(std::thread::hardware_concurrency()),
+                    lowMemory(false),
+                    showStats(false),
+                    memLimit(0),
+                    maxGap(-1),
+                    deadline(0),
+                    estimate(false),
+                    winnow(false),
+                    similarity(0),
+                    trees(false),
+                    crossFile(false),
+                    minInstances(2),
+                    profile(false),
+                    query(false),
+                    fileSet(Bookmark::NO_SET)
 {
+    if (nrOfThreads < 1)
+        nrOfThreads = 1;
 }
 
 void Options::parse(int argc, char* argv[])
@@ -35,11 +54,66 @@ void Options::parse(int argc, char* argv[])
         else
             processFileName(argv[i]);
 
-    if (Bookmark::totalLength() == 0)
+    // The files of an index are in it, and any others are looked up in it.
+    if (query && indexDir.empty())
+    {
+        std::cerr << "--query can only be given with --index." << std::endl;
+        printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
+    }
+    if (not indexDir.empty())
+    {
+        if ((not files.empty() && not query) || not buildIndex.empty() ||
+            not updateIndex.empty())
+        {
+            std::cerr << "Files can't be given with --index, unless with "
+                      << "--query, nor can --build-index or --update-index."
+                      << std::endl;
+            printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+        // The test files can't be left out, since they're in the index.
+        if (totalReport == RESTRICTED_TOTAL)
+        {
+            std::cerr << "-t can't be given with --index, since the index "
+                      << "holds the test files too. Give -T instead."
+                      << std::endl;
+            printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+        if (query && files.empty())
+            for (string name; std::getline(std::cin, name);)
+                if (not name.empty())
+                    files.push_back(std::make_pair(name, fileSet));
+        return;
+    }
+
+    if (files.empty())
     {
         std::cerr << "No files found" << std::endl;
         printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
     }
+
+    // Either no file is in a set, or there are files in both and no others.
+    size_t nrInSet[3] = { 0, 0, 0 };
+    for (size_t file = 0; file < files.size(); ++file)
+        ++nrInSet[files[file].second];
+    if (nrInSet[Bookmark::NO_SET] < files.size() &&
+        (nrInSet[Bookmark::NO_SET] > 0 || nrInSet[Bookmark::LEFT_SET] == 0 ||
+         nrInSet[Bookmark::RIGHT_SET] == 0))
+    {
+        std::cerr << "Files must be given after both --left and --right, "
+                  << "and not before them." << std::endl;
+        printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
+    }
+
+    // When an index is updated, only the files that have changed are read.
+    if (not buildIndex.empty() && not updateIndex.empty())
+    {
+        std::cerr << "Only one of --build-index and --update-index can be "
+                  << "given." << std::endl;
+        printUsageAndExit(Options::SHOW_EXT_FLAGS, EXIT_FAILURE);
+    }
+    if (updateIndex.empty())
+        for (size_t file = 0; file < files.size(); ++file)
+            Bookmark::addFile(files[file].first, files[file].second);
 }
 
 int Options::processFlag(int i, int argc, char* argv[])
@@ -76,7 +150,7 @@ int Options::processFlag(int i, int argc, char* argv[])
             if (not isRestrictedTotal ||
                 foundFiles[ii].find("test") == string::npos)
             {
-                Bookmark::addFile(foundFiles[ii]);
+                files.push_back(std::make_pair(foundFiles[ii], fileSet));
             }
         }
         foundFiles.clear();
@@ -105,15 +179,148 @@ int Options::processFlag(int i, int argc, char* argv[])
             printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
         }
         break;
+    case 'j':
+        nrOfThreads = atoi((arg[2] == '\0') ? argv[++i] : &arg[2]);
+        if (nrOfThreads < 1)
+        {
+            cerr << "Number of threads must be at least 1." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+        break;
+    case 'i':
+        minInstances = atoi((arg[2] == '\0') ? argv[++i] : &arg[2]);
+        if (minInstances < 2)
+        {
+            cerr << "Number of instances must be at least 2." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+        break;
+    case 'l':
+        lowMemory = true;
+        break;
+    case 's':
+        showStats = true;
+        break;
     case 'h':
         printUsageAndExit(SHOW_EXT_FLAGS, EXIT_SUCCESS);
         break;
+    case '-':
+        return processLongFlag(i, argc, argv);
     default:
         printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
     }
     return i;
 }
 
+/**
+ * Handles flags like --name value or --name=value.
+ */
+int Options::processLongFlag(int i, int argc, char* argv[])
+{
+    const string arg   = argv[i];
+    const size_t equal = arg.find('=');
+    const string name  = arg.substr(0, equal);
+    // The value either follows an equal sign or is the next argument.
+    auto value = [&]() -> const char* {
+        if (equal != string::npos)
+            return &argv[i][equal + 1];
+        return (i + 1 < argc) ? argv[++i] : "";
+    };
+
+    if (name == "--mem-limit")
+    {
+        // In megabytes unless followed by K or G. strtoull accepts a sign and
+        // leading spaces, so the number must start with a digit, and it must
+        // not overflow when the unit is applied.
+        const char*        limit      = value();
+        char*              unit       = 0;
+        size_t             multiplier = 1024 * 1024;
+        unsigned long long number     = strtoull(limit, &unit, 10);
+        if (*unit == 'K' || *unit == 'G')
+            multiplier = (*unit == 'K') ? 1024 : multiplier * 1024;
+        if (not isdigit(limit[0]) || number > SIZE_MAX / multiplier ||
+            (*unit != '\0' && (std::strchr("KMG", *unit) == 0 || unit[1])))
+        {
+            number = 0;
+        }
+        memLimit = number * multiplier;
+        if (memLimit == 0)
+        {
+            cerr << "Memory limit must be a positive number of megabytes, "
+                 << "optionally followed by K, M or G." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else if (name == "--gap")
+    {
+        const char* gap = value();
+        maxGap = atoi(gap);
+        if (not isdigit(gap[0]))
+        {
+            cerr << "Gap must be a number of characters." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else if (name == "--deadline")
+    {
+        deadline = atof(value());
+        if (deadline <= 0)
+        {
+            cerr << "Deadline must be a positive number of seconds." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else if (name == "--estimate")
+        estimate = true;
+    else if (name == "--winnow")
+        winnow = true;
+    else if (name == "--trees")
+        trees = true;
+    else if (name == "--cross-file")
+        crossFile = true;
+    else if (name == "--profile")
+        profile = true;
+    else if (name == "--cache")
+    {
+        cacheFile = value();
+        if (cacheFile.empty())
+        {
+            cerr << "Cache must be a file name." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else if (name == "--build-index" || name == "--update-index" ||
+             name == "--index")
+    {
+        string& directory = (name == "--index")       ? indexDir :
+                            (name == "--build-index") ? buildIndex :
+                                                        updateIndex;
+        directory = value();
+        if (directory.empty())
+        {
+            cerr << "Index must be a directory." << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else if (name == "--query")
+        query = true;
+    else if (name == "--left" || name == "--right")
+        fileSet = (name == "--left") ? Bookmark::LEFT_SET : Bookmark::RIGHT_SET;
+    else if (name == "--similar")
+    {
+        similarity = atof(value());
+        if (similarity <= 0 || similarity > 1)
+        {
+            cerr << "Similarity must be a number above 0 and at most 1."
+                 << endl;
+            printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+        }
+    }
+    else
+        printUsageAndExit(SHOW_EXT_FLAGS, EXIT_FAILURE);
+    return i;
+}
+
 void Options::findFiles(const string& dirName, const string& ending)
 {
     DIR* dir = opendir(dirName.c_str());
@@ -152,7 +359,7 @@ void Options::processFileName(const string& arg)
              << endl;
     }
     else
-        Bookmark::addFile(arg);
+        files.push_back(std::make_pair(arg, fileSet));
 }
 
 void Options::printUsageAndExit(ExtFlagMode extFlagMode, int exitCode)
@@ -165,8 +372,15 @@ void Options::printUsageAndExit(ExtFlagMode extFlagMode, int exitCode)
        << (extFlagMode == SHOW_EXT_FLAGS ? "[-p<n>] " : "") << "<files>\n"
        << "       dupfind -t"
        << (extFlagMode == SHOW_EXT_FLAGS ? "|-T" : "")
-       << " [-v] [-w] <files>\n"
-       << "       -v:    verbose, print strings that are duplicated\n"
+       << " [-v] [-w] <files>\n";
+    if (extFlagMode == SHOW_EXT_FLAGS)
+        os << "       dupfind [<flags>] --left <files> --right <files>\n"
+           << "       dupfind [<flags>] --build-index <dir>|--update-index <dir> "
+           << "<files>\n"
+           << "       dupfind [<flags>] --index <dir> [--query [<files>]]\n"
+           << "       (<flags> are any of those below, and -e can be given "
+           << "instead of <files>)\n";
+    os << "       -v:    verbose, print strings that are duplicated\n"
        << "       -w:    calculate duplication based on words rather than "
        << "lines\n"
        << "       -10:   report the 10 longest duplications instead of 5,"
@@ -184,7 +398,72 @@ void Options::printUsageAndExit(ExtFlagMode extFlagMode, int exitCode)
        << "can be given)\n";
     if (extFlagMode == SHOW_EXT_FLAGS)
         os << "       -p50:  use 50% proximity (more but shorter matches); "
-           << "90% is default\n";
+           << "90% is default\n"
+           << "       -i3:   report only duplications with at least 3 "
+           << "instances; 2 is default\n"
+           << "       -j8:   sort with 8 threads; default is one per CPU "
+           << "core\n"
+           << "       -l:    use less memory for sorting and searching, "
+           << "which is then slower\n"
+           << "       -s:    print statistics about the search on stderr\n"
+           << "       --mem-limit 500: if sorting needs more than 500 MB "
+           << "besides the text and\n"
+           << "              the bookmarks, sort in runs on disk and search "
+           << "like -l instead\n"
+           << "       --gap 20: report duplications where a few lines differ, "
+           << "chaining exact\n"
+           << "              parts that are at most 20 characters apart\n"
+           << "       --deadline 60: search coarsely first and print the best "
+           << "duplications\n"
+           << "              found so far, marked as partial, after 60 "
+           << "seconds\n"
+           << "       --estimate: estimate the total duplication from a "
+           << "sample instead of\n"
+           << "              finding all duplications, but all files are "
+           << "still parsed\n"
+           << "       --winnow: find duplications from fingerprints of the "
+           << "text instead of\n"
+           << "              sorting, for very large inputs; all that are at "
+           << "least -m long\n"
+           << "              are found, but approximate ones are not\n"
+           << "       --similar 0.8: list pairs of files that are at least "
+           << "80% alike as a\n"
+           << "              whole instead, by their estimated Jaccard "
+           << "similarity\n"
+           << "       --trees: report copied directories first, exact ones "
+           << "and ones with\n"
+           << "              at least the proximity share of their files in "
+           << "common, and leave\n"
+           << "              the copied files out of the search\n"
+           << "       --left <files> --right <files>: report only "
+           << "duplications between the\n"
+           << "              two sets of files, which may also be given "
+           << "with -e\n"
+           << "       --cross-file: report only duplications with instances "
+           << "in more than one\n"
+           << "              file\n"
+           << "       --profile: count the clones of at least -m characters "
+           << "by length and by\n"
+           << "              file ending instead of reporting them\n"
+           << "       --cache <file>: keep the parsed text of the files in "
+           << "the file between\n"
+           << "              runs and parse only the files that have "
+           << "changed\n"
+           << "       --build-index <dir>: parse and sort the files once and "
+           << "write them to an\n"
+           << "              index in the directory instead of searching "
+           << "them\n"
+           << "       --update-index <dir>: bring an index up to date with "
+           << "the files,\n"
+           << "              parsing and sorting only those that have "
+           << "changed\n"
+           << "       --index <dir>: search the files of an index instead of "
+           << "parsing and\n"
+           << "              sorting them again\n"
+           << "       --query: look up the files, or those named on standard "
+           << "input, in the\n"
+           << "              index given with --index and report where their "
+           << "text is found\n";
     os << "       -t:    set -m100 and sum up the total duplication\n";
     if (extFlagMode == SHOW_EXT_FLAGS)
         os << "       -T:    same as -t but accept any file (test code etc.)"
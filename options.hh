@@ -2,8 +2,11 @@
 #define OPTIONS_HH
 
 #include <string>
+#include <utility> // pair
 #include <vector>
 
+#include "bookmark.hh" // FileSet
+
 class Options
 {
 public:
@@ -16,7 +19,30 @@ public:
     int                      minLength;
     int                      proximityFactor;
     bool                     wordMode;
+    int                      nrOfThreads;
+    bool                     lowMemory;
+    bool                     showStats;
+    size_t                   memLimit; // Bytes for sorting, 0 if no limit.
+    int                      maxGap;   // Between chained matches, -1 if none.
+    double                   deadline; // Seconds, 0 if none.
+    bool                     estimate;
+    bool                     winnow;   // Find by fingerprints, not sorting.
+    double                   similarity; // Of similar files, 0 if not wanted.
+    bool                     trees;    // Report copied directories first.
+    bool                     crossFile;    // Only duplications across files.
+    int                      minInstances; // Of a reported duplication.
+    bool                     profile;  // Sum up by length, don't report.
+    bool                     query;    // Look the files up in the index.
+    std::string              cacheFile; // Of parsed files, empty if none.
+    std::string              buildIndex;  // Directory to write an index to.
+    std::string              updateIndex; // Directory of an index.
+    std::string              indexDir;    // Of the index to search.
+    Bookmark::FileSet        fileSet;  // Of the files that follow.
     std::vector<std::string> foundFiles;
+
+    // The files to search, or to look up in an index, in the order they
+    // were given, with their sets.
+    std::vector<std::pair<std::string, Bookmark::FileSet> > files;
     std::vector<std::string> excludes;
 
     Options();
@@ -27,6 +53,7 @@ public:
 
 private:
     int processFlag(int i, int argc, char* argv[]);
+    int processLongFlag(int i, int argc, char* argv[]);
     void processFileName(const std::string& arg);
     void findFiles(const std::string& name, const std::string& ending);
 };
@@ -0,0 +1,235 @@
+#include "parse_cache.hh"
+#include "file.hh" // SPECIAL_EOF
+
+#include <cstdio>     // fopen, fread, fwrite, rename
+#include <cstring>    // memcpy
+#include <iostream>   // cerr
+#include <sys/stat.h> // stat
+#include <utility>    // move
+
+// Changed whenever the format of the file or the way of parsing changes.
+static const char MAGIC[] = "dupfind parse cache 2\n";
+
+static const uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+static const uint64_t FNV_PRIME  = 0x100000001b3ULL;
+
+static uint64_t hashOf(const char* bytes, size_t length, uint64_t hash)
+{
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * FNV_PRIME;
+    return hash;
+}
+
+// Of the parsed part of an entry, which the key doesn't cover, so that an
+// entry that was damaged on disk is not used.
+static uint64_t checksumOf(const ParseCache::Entry& entry)
+{
+    uint64_t checksum = hashOf(entry.processed.data(), entry.processed.size(),
+                               FNV_OFFSET);
+    checksum = hashOf(reinterpret_cast<const char*>(entry.markOffsets.data()),
+                      entry.markOffsets.size() * sizeof(uint64_t), checksum);
+    return hashOf(reinterpret_cast<const char*>(entry.markOriginals.data()),
+                  entry.markOriginals.size() * sizeof(uint64_t), checksum);
+}
+
+static bool readNumber(FILE* file, uint64_t& number)
+{
+    return fread(&number, sizeof number, 1, file) == 1;
+}
+
+static bool writeNumber(FILE* file, uint64_t number)
+{
+    return fwrite(&number, sizeof number, 1, file) == 1;
+}
+
+// Numbers are read into a string or vector in one go, but not more than are
+// left in the file, so that a damaged file can't make them huge.
+static bool readString(FILE* file, uint64_t length, std::string& s)
+{
+    const long position = ftell(file);
+    if (position < 0 || fseek(file, 0, SEEK_END) != 0)
+        return false;
+    const long size = ftell(file);
+    if (size < position || fseek(file, position, SEEK_SET) != 0 ||
+        length > uint64_t(size - position))
+    {
+        return false;
+    }
+    s.resize(length);
+    return length == 0 || fread(&s[0], 1, length, file) == length;
+}
+
+// Could the entry be what a file of the given length, with its SPECIAL_EOF,
+// was parsed into? Each character of the file becomes at most one processed
+// character, and the bookmarks are in order within both texts.
+static bool isConsistent(const ParseCache::Entry& entry, size_t length)
+{
+    const std::string& processed = entry.processed;
+    if (processed.empty() || processed.size() > length ||
+        processed.back() != SPECIAL_EOF ||
+        processed.find('\0') != std::string::npos)
+    {
+        return false;
+    }
+    for (size_t m = 0; m < entry.markOffsets.size(); ++m)
+        if (entry.markOffsets[m] >= processed.size() - 1 ||
+            entry.markOriginals[m] >= length ||
+            (m > 0 && (entry.markOffsets[m] <= entry.markOffsets[m - 1] ||
+                       entry.markOriginals[m] <= entry.markOriginals[m - 1])))
+        {
+            return false;
+        }
+    return true;
+}
+
+static bool readNumbers(FILE* file, std::vector<uint64_t>& numbers)
+{
+    uint64_t    size;
+    std::string bytes;
+    if (not readNumber(file, size) || size > UINT64_MAX / sizeof size ||
+        not readString(file, size * sizeof size, bytes))
+    {
+        return false;
+    }
+    numbers.resize(size);
+    if (size > 0)
+        std::memcpy(&numbers[0], bytes.data(), bytes.size());
+    return true;
+}
+
+static bool writeNumbers(FILE* file, const std::vector<uint64_t>& numbers)
+{
+    return writeNumber(file, numbers.size()) &&
+        fwrite(numbers.data(), sizeof(uint64_t), numbers.size(), file) ==
+        numbers.size();
+}
+
+ParseCache::ParseCache(const std::string& path):
+    itsPath(path),
+    itsNrOfHits(0),
+    itsNrOfMisses(0)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == 0)
+        return;
+    // A damaged cache is as good as none.
+    if (not read(file))
+        itsOldEntries.clear();
+    fclose(file);
+}
+
+const ParseCache::Entry* ParseCache::find(const std::string& fileName,
+                                          const char*        content,
+                                          size_t             length,
+                                          Entry&             key)
+{
+    struct stat s;
+    const bool  isFound = stat(fileName.c_str(), &s) == 0;
+    key.size     = isFound ? s.st_size : 0;
+    key.modified = isFound ? s.st_mtime : -1;
+    key.hash     = hashOf(content, length, FNV_OFFSET);
+
+    const auto it = itsOldEntries.find(fileName);
+    if (it != itsOldEntries.end() && key.modified != -1 &&
+        it->second.size == key.size && it->second.modified == key.modified &&
+        it->second.hash == key.hash && it->second.wordMode == key.wordMode &&
+        it->second.startsWithMark == key.startsWithMark &&
+        isConsistent(it->second, length))
+    {
+        ++itsNrOfHits;
+        itsNewEntries[fileName] = it->second;
+        return &it->second;
+    }
+    ++itsNrOfMisses;
+    return 0;
+}
+
+void ParseCache::store(const std::string& fileName, const Entry& entry)
+{
+    itsNewEntries[fileName] = entry;
+}
+
+/**
+ * Writes to a temporary file next to the cache and renames it, so that the
+ * cache is never left half written.
+ */
+void ParseCache::save() const
+{
+    const std::string temporary = itsPath + ".tmp";
+    FILE*             file      = fopen(temporary.c_str(), "wb");
+    bool              isOk      = file != 0 &&
+        fwrite(MAGIC, 1, sizeof MAGIC, file) == sizeof MAGIC &&
+        writeNumber(file, itsNewEntries.size());
+    for (auto it = itsNewEntries.begin();
+         isOk && it != itsNewEntries.end(); ++it)
+    {
+        const Entry& entry = it->second;
+        const uint64_t flags = entry.wordMode | entry.startsWithMark << 1 |
+                               entry.endsWithMark << 2;
+        isOk = writeNumber(file, it->first.size()) &&
+            fwrite(it->first.data(), 1, it->first.size(), file) ==
+            it->first.size() &&
+            writeNumber(file, entry.size) &&
+            writeNumber(file, entry.modified) &&
+            writeNumber(file, entry.hash) &&
+            writeNumber(file, flags) &&
+            writeNumber(file, entry.processed.size()) &&
+            fwrite(entry.processed.data(), 1, entry.processed.size(), file) ==
+            entry.processed.size() &&
+            writeNumbers(file, entry.markOffsets) &&
+            writeNumbers(file, entry.markOriginals) &&
+            writeNumber(file, checksumOf(entry));
+    }
+    if (file != 0 && fclose(file) != 0)
+        isOk = false;
+    if (not isOk || rename(temporary.c_str(), itsPath.c_str()) != 0)
+    {
+        std::cerr << "dupfind: Could not write the cache " << itsPath
+                  << ".\n";
+        remove(temporary.c_str());
+    }
+}
+
+bool ParseCache::read(FILE* file)
+{
+    char     magic[sizeof MAGIC];
+    uint64_t nrOfEntries;
+    if (fread(magic, 1, sizeof magic, file) != sizeof magic ||
+        std::string(magic, sizeof magic) != std::string(MAGIC, sizeof MAGIC) ||
+        not readNumber(file, nrOfEntries))
+    {
+        return false;
+    }
+    for (uint64_t e = 0; e < nrOfEntries; ++e)
+    {
+        uint64_t    length;
+        uint64_t    modified;
+        uint64_t    flags;
+        uint64_t    checksum;
+        std::string fileName;
+        Entry       entry;
+        if (not readNumber(file, length) ||
+            not readString(file, length, fileName) ||
+            not readNumber(file, entry.size) ||
+            not readNumber(file, modified) ||
+            not readNumber(file, entry.hash) ||
+            not readNumber(file, flags) ||
+            not readNumber(file, length) ||
+            not readString(file, length, entry.processed) ||
+            not readNumbers(file, entry.markOffsets) ||
+            not readNumbers(file, entry.markOriginals) ||
+            not readNumber(file, checksum) ||
+            entry.markOffsets.size() != entry.markOriginals.size())
+        {
+            return false;
+        }
+        if (checksum != checksumOf(entry))
+            continue;
+        entry.modified       = modified;
+        entry.wordMode       = flags & 1;
+        entry.startsWithMark = flags & 2;
+        entry.endsWithMark   = flags & 4;
+        itsOldEntries[fileName] = std::move(entry);
+    }
+    return true;
+}
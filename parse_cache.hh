@@ -0,0 +1,69 @@
+#ifndef PARSE_CACHE_HH
+#define PARSE_CACHE_HH
+
+#include <cstdint>
+#include <cstdio> // FILE
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Keeps the processed text of each file in a file on disk between runs, so
+ * that only the files that have changed since the last run need to be
+ * parsed. A file is looked up by its path, and it is only found if its size,
+ * modification time and a hash of its content are the same as when it was
+ * stored, and if it was parsed the same way.
+ *
+ * Only the files of the current run are written back, so files that are no
+ * longer searched drop out of the cache.
+ */
+class ParseCache
+{
+public:
+    // The processed text of a file, with the bookmarks in it.
+    struct Entry
+    {
+        uint64_t              size;
+        int64_t               modified; // Seconds since the epoch.
+        uint64_t              hash;     // Of the content.
+        bool                  wordMode;
+        bool                  startsWithMark; // If a bookmark was due then.
+        bool                  endsWithMark;   // If one is due after it.
+        std::string           processed;      // With the SPECIAL_EOF.
+        std::vector<uint64_t> markOffsets;    // Into the processed text.
+        std::vector<uint64_t> markOriginals;  // Into the content.
+    };
+
+    // Reads the cache from the file if there is one, and if it's not from an
+    // incompatible version.
+    explicit ParseCache(const std::string& path);
+
+    /**
+     * Returns the entry of a file whose content and way of parsing are the
+     * same as given, or 0 if there is none or it's damaged. The rest of the
+     * entry is filled in for storing the file when it's not found.
+     */
+    const Entry* find(const std::string& fileName,
+                      const char*        content,
+                      size_t             length,
+                      Entry&             key);
+
+    void store(const std::string& fileName, const Entry& entry);
+
+    // Writes the entries of the files in this run back to the file.
+    void save() const;
+
+    size_t nrOfHits() const { return itsNrOfHits; }
+    size_t nrOfMisses() const { return itsNrOfMisses; }
+
+private:
+    bool read(FILE* file);
+
+    const std::string            itsPath;
+    std::map<std::string, Entry> itsOldEntries;
+    std::map<std::string, Entry> itsNewEntries;
+    size_t                       itsNrOfHits;
+    size_t                       itsNrOfMisses;
+};
+
+#endif
@@ -2,11 +2,12 @@
 #include "file.hh" // SPECIAL_EOF
 #include "bookmark.hh"
 #include "bookmark_container.hh"
+#include "compare.hh" // COMPARE_PADDING
 
 #include <iostream>
 #include <map>
 #include <string>
-#include <cstring> // strncmp
+#include <cstring> // memcpy, strncmp
 
 using std::map;
 using std::string;
@@ -69,23 +70,115 @@ const char* Parser::stateToString(Parser::State s)
  * Reads the original text into a processed text, which is returned. Also sets
  * the bookmarks to point into the two strings.
  */
-const char* Parser::process(bool wordMode)
+const char* Parser::process(bool wordMode, size_t firstFileNr)
 {
     const Matrix& matrix = wordMode ? textBehavior() : codeBehavior();
+    size_t        begin  =
+        (firstFileNr == 0) ? 0 : Bookmark::fileEnd(firstFileNr - 1);
 
-    itsProcessedText = new char[Bookmark::totalLength()];
+    // Leave room for the terminating null character and for the vectorized
+    // comparisons, which may read a bit past the end.
+    itsProcessedText =
+        new char[Bookmark::totalLength() - begin + 1 + COMPARE_PADDING]();
+    itsContainer.setText(itsProcessedText);
 
+    for (size_t fileNr = firstFileNr; fileNr < Bookmark::nrOfFiles();
+         ++fileNr)
+    {
+        const size_t             end    = Bookmark::fileEnd(fileNr);
+        const ParseCache::Entry* reused =
+            (fileNr < itsReused.size()) ? itsReused[fileNr] : 0;
+        itsMarksDue.push_back(timeForNewBookmark);
+        if (reused != 0 && reused->startsWithMark == timeForNewBookmark)
+            splice(begin, *reused);
+        else if (reused != 0)
+        {
+            itsReused[fileNr] = 0;
+            processFile(begin, end, matrix);
+        }
+        else if (itsCache == 0)
+            processFile(begin, end, matrix);
+        else
+            processCached(begin, end, matrix, wordMode);
+        begin = end;
+    }
+    itsMarksDue.push_back(timeForNewBookmark);
+
+    addChar('\0', Bookmark::totalLength());
+
+    return itsProcessedText;
+}
+
+/**
+ * Parses the original text of a file. Every file ends with a SPECIAL_EOF,
+ * which brings the state back to NORMAL.
+ */
+void Parser::processFile(size_t begin, size_t end, const Matrix& matrix)
+{
     State state = NORMAL;
-    for (size_t i = 0; i < Bookmark::totalLength(); ++i)
+    for (size_t i = begin; i < end; ++i)
     {
         state = processChar(state, matrix, i);
         // std::cout << stateToString(state) << ' '
         //           << Bookmark::getChar(i) << "\n";
     }
+}
 
-    addChar('\0', Bookmark::totalLength());
+void Parser::reuse(size_t fileNr, const ParseCache::Entry* entry)
+{
+    if (itsReused.size() <= fileNr)
+        itsReused.resize(fileNr + 1);
+    itsReused[fileNr] = entry;
+}
 
-    return itsProcessedText;
+/**
+ * Copies the processed text and bookmarks of a file that begins at the given
+ * index in the original text.
+ */
+void Parser::splice(size_t begin, const ParseCache::Entry& entry)
+{
+    char* const processed = itsProcessedText + itsProcessedIx;
+    memcpy(processed, entry.processed.data(), entry.processed.size());
+    for (size_t m = 0; m < entry.markOffsets.size(); ++m)
+        itsContainer.addBookmark(Bookmark(begin + entry.markOriginals[m],
+                                          processed + entry.markOffsets[m]));
+    itsProcessedIx    += entry.processed.size();
+    timeForNewBookmark = entry.endsWithMark;
+}
+
+/**
+ * Copies the processed text and bookmarks of a file from the cache if it's
+ * there. Otherwise parses the file and stores the result in the cache. What
+ * a file becomes depends only on its text, its name and whether a bookmark
+ * is due when it begins.
+ */
+void Parser::processCached(size_t        begin,
+                           size_t        end,
+                           const Matrix& matrix,
+                           bool          wordMode)
+{
+    const std::string        fileName = Bookmark::getFileName(begin);
+    ParseCache::Entry        entry;
+    entry.wordMode       = wordMode;
+    entry.startsWithMark = timeForNewBookmark;
+    const ParseCache::Entry* cached   =
+        itsCache->find(fileName, &Bookmark::getChar(begin), end - begin,
+                       entry);
+    if (cached != 0)
+    {
+        splice(begin, *cached);
+        return;
+    }
+
+    itsEntry         = &entry;
+    itsEntryBegin    = itsProcessedIx;
+    itsEntryOriginal = begin;
+    processFile(begin, end, matrix);
+    itsEntry = 0;
+    entry.processed.assign(itsProcessedText + itsEntryBegin,
+                           itsProcessedIx - itsEntryBegin);
+    entry.endsWithMark = timeForNewBookmark;
+    itsCache->store(fileName, entry);
 }
 
 static bool lookaheadIs(const string& s, const char& c)
@@ -127,7 +220,7 @@ Parser::State Parser::processChar(State         state,
             if (lookaheadIs(imports, c) || lookaheadIs(usings, c))
                 state = SKIP_TO_EOL;
             else
-                itsContainer.addBookmark(addChar(c, i));
+                addBookmark(c, i);
         else
             addChar(c, i);
 
@@ -183,19 +276,18 @@ void Parser::performAction(Action action, char c, size_t i)
             addChar(c, i);
         break;
     case ADD_CHAR:
-    {
-        const Bookmark bm = addChar(c, i);
         if (timeForNewBookmark)
-            itsContainer.addBookmark(bm);
+            addBookmark(c, i);
+        else
+            addChar(c, i);
         timeForNewBookmark = false;
         break;
-    }
     case ADD_BOOKMARK:
         timeForNewBookmark = true;
         break;
     case ADD_SPACE:
         addChar(' ', i);
-        itsContainer.addBookmark(addChar(c, i));
+        addBookmark(c, i);
         break;
     case NA:
         break;
@@ -206,11 +298,24 @@ void Parser::performAction(Action action, char c, size_t i)
  * Adds a character to the processed string and sets a bookmark, which is then
  * returned.
  */
-Bookmark Parser::addChar(char c, int originalIndex)
+Bookmark Parser::addChar(char c, size_t originalIndex)
 {
-    static int procIx;
-    itsProcessedText[procIx] = c;
-    return Bookmark(originalIndex, &itsProcessedText[procIx++]);
+    itsProcessedText[itsProcessedIx] = c;
+    return Bookmark(originalIndex, &itsProcessedText[itsProcessedIx++]);
+}
+
+/**
+ * Adds a character and a bookmark at it, which is also noted for the cache
+ * when a file is being stored in it.
+ */
+void Parser::addBookmark(char c, size_t originalIndex)
+{
+    itsContainer.addBookmark(addChar(c, originalIndex));
+    if (itsEntry != 0)
+    {
+        itsEntry->markOffsets.push_back(itsProcessedIx - 1 - itsEntryBegin);
+        itsEntry->markOriginals.push_back(originalIndex - itsEntryOriginal);
+    }
 }
 
 const Parser::Matrix& Parser::codeBehavior() const
@@ -4,6 +4,9 @@
 #include <cstdlib> // size_t
 #include <map>
 #include <string>
+#include <vector>
+
+#include "parse_cache.hh"
 
 class Bookmark;
 class BookmarkContainer;
@@ -32,14 +35,44 @@ class Parser
     typedef std::map<Key, Value> Matrix;
 
 public:
-    Parser(BookmarkContainer& container): timeForNewBookmark(true),
-                                          itsContainer(container) {}
-    const char* process(bool wordMode);
+    // Files that are the same as in the cache, if one is given, are taken
+    // from it instead of being parsed, and the others are stored in it.
+    Parser(BookmarkContainer& container, ParseCache* cache = 0):
+        timeForNewBookmark(true),
+        itsContainer(container),
+        itsCache(cache),
+        itsProcessedIx(0),
+        itsEntry(0) {}
+
+    // Only the files from the given one on are parsed, such as those that
+    // are looked up in an index.
+    const char* process(bool wordMode, size_t firstFileNr = 0);
+
+    // Takes the processed text of a file from the entry instead of parsing
+    // it, unless a bookmark wasn't due at its beginning in the same way.
+    void reuse(size_t fileNr, const ParseCache::Entry* entry);
+
+    // Was the file taken from the entry given for it after processing?
+    bool isReused(size_t fileNr) const
+    {
+        return fileNr < itsReused.size() && itsReused[fileNr] != 0;
+    }
+
+    // Whether a bookmark was due at the beginning of each file, and at the
+    // end of the last one.
+    const std::vector<bool>& marksDue() const { return itsMarksDue; }
 
 private:
+    void          processFile(size_t begin, size_t end, const Matrix& matrix);
+    void          splice(size_t begin, const ParseCache::Entry& entry);
+    void          processCached(size_t        begin,
+                                size_t        end,
+                                const Matrix& matrix,
+                                bool          wordMode);
     State         processChar(State state, const Matrix& matrix, size_t i);
     void          performAction(Action action, char c, size_t i);
-    Bookmark      addChar(char c, int originalIndex);
+    Bookmark      addChar(char c, size_t originalIndex);
+    void          addBookmark(char c, size_t originalIndex);
     const Matrix& codeBehavior() const;
     const Matrix& textBehavior() const;
     Language      getLanguage(const std::string& fileName);
@@ -47,7 +80,18 @@ private:
 
     bool               timeForNewBookmark;
     BookmarkContainer& itsContainer;
+    ParseCache*        itsCache;
     char*              itsProcessedText;
+    size_t             itsProcessedIx;
+
+    // By file number, and left only for the files that were taken from them.
+    std::vector<const ParseCache::Entry*> itsReused;
+    std::vector<bool>                     itsMarksDue;
+
+    // The file being parsed for the cache, and where it begins.
+    ParseCache::Entry* itsEntry;
+    size_t             itsEntryBegin;
+    size_t             itsEntryOriginal;
 };
 
 #endif
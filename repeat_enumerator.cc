@@ -0,0 +1,369 @@
+#include "repeat_enumerator.hh"
+#include "bookmark_container.hh"
+#include "duplication.hh"
+#include "file.hh" // SPECIAL_EOF
+
+#include <algorithm> // lower_bound, min, sort, upper_bound
+#include <cstdint>   // SIZE_MAX
+#include <cstring>   // strchr
+
+static const size_t NONE = SIZE_MAX;
+
+RepeatEnumerator::RepeatEnumerator(BookmarkContainer& container,
+                                   int                minLength,
+                                   int                proximityFactor,
+                                   int                minInstances):
+    itsContainer(container),
+    itsMinLength(minLength),
+    itsDepth(container.sortDepth()),
+    itsProximityFactor(proximityFactor),
+    itsMinInstances(minInstances),
+    itsSame(container.size(), 0),
+    itsPrevious(container.size()),
+    itsNext(container.size()),
+    itsByOffset(container.size()),
+    itsPositions(container.size()),
+    itsLeftFrom(container.size() + 1)
+{
+    const size_t size = container.size();
+    for (size_t ix = 0; ix < size; ++ix)
+    {
+        itsPrevious[ix] = (ix == 0) ? NONE : ix - 1;
+        itsNext[ix]     = (ix + 1 == size) ? NONE : ix + 1;
+        itsByOffset[ix] = ix;
+        itsLeftFrom[ix] = ix;
+    }
+    itsLeftFrom[size] = size;
+
+    std::sort(itsByOffset.begin(), itsByOffset.end(),
+              [&](size_t a, size_t b) {
+                  return container.offset(a) < container.offset(b);
+              });
+    for (size_t position = 0; position < size; ++position)
+        itsPositions[itsByOffset[position]] = position;
+
+    for (const char* eof = strchr(container.text(), SPECIAL_EOF); eof != 0;
+         eof = strchr(eof + 1, SPECIAL_EOF))
+    {
+        itsEofs.push_back(eof - container.text());
+    }
+
+    // Within a group, the pairs get as many common characters as the
+    // bookmarks are sorted by for now, unless a file ends before that.
+    size_t begin = 0;
+    for (size_t ix = 0; ix < size; ++ix)
+    {
+        if (ix + 1 < size)
+            itsSame[ix] = container.nrOfSame(ix, ix + 1, itsDepth);
+        if (itsDepth == SIZE_MAX)
+        {
+            // Sorted all the way, so there are no groups.
+            addPair(ix);
+            continue;
+        }
+        if (ix + 1 == size ||
+            (itsSame[ix] < itsDepth &&
+             not container.samePrefix(ix, ix + 1, itsDepth)))
+        {
+            if (ix > begin)
+            {
+                itsGroupBegins.push_back(begin);
+                itsGroupEnds.push_back(ix + 1);
+            }
+            begin = ix + 1;
+        }
+    }
+    itsRefined.assign(itsGroupBegins.size(), false);
+
+    // The last bookmark in sorted order must be known from the start, since
+    // it is never removed.
+    if (size > 0)
+        refineGroupOf(size - 1);
+
+    for (size_t group = 0; group < itsGroupBegins.size(); ++group)
+        if (not itsRefined[group] &&
+            itsSame[itsGroupBegins[group]] == itsDepth)
+        {
+            const size_t bound = upperBound(group);
+            if (bound >= itsMinLength)
+                itsGroups.push(Pair(bound, group));
+        }
+}
+
+/**
+ * Works like Dupfind::findWorst() followed by clearing the bookmarks within
+ * the found duplication.
+ */
+bool RepeatEnumerator::next(Duplication&         duplication,
+                            std::vector<size_t>& instances)
+{
+    size_t worst = NONE;
+    while (worst == NONE)
+    {
+        // Skip pairs that have been split up or got fewer common characters
+        // since they were added.
+        while (not itsPairs.empty() &&
+               runSame(itsPairs.top().second) != itsPairs.top().first)
+        {
+            itsPairs.pop();
+        }
+
+        // A group that may hold as many common characters as the best pair
+        // is sorted further first, unless fewer are left in it by now.
+        if (itsGroups.empty() ||
+            (not itsPairs.empty() &&
+             itsGroups.top().first < itsPairs.top().first))
+        {
+            if (itsPairs.empty())
+                return false;
+
+            // A pair is exact, but a longer run may reach into groups that
+            // are not sorted all the way. Once they are, the run is added
+            // again if it has changed.
+            worst = itsPairs.top().second;
+            for (size_t i = 0, ix = worst; i < itsMinInstances && ix != NONE;
+                 ++i, ix = itsNext[ix])
+            {
+                refineGroupOf(ix);
+            }
+            if (runSame(worst) != itsPairs.top().first)
+                worst = NONE;
+            continue;
+        }
+        const size_t bound = itsGroups.top().first;
+        const size_t group = itsGroups.top().second;
+        itsGroups.pop();
+        if (itsRefined[group])
+            continue;
+        const size_t newBound = upperBound(group);
+        if (newBound >= bound)
+            refine(group);
+        else if (newBound >= itsMinLength)
+            itsGroups.push(Pair(newBound, group));
+    }
+
+    // The groups that the walks below reach into must be sorted all the way
+    // too.
+    duplication.longestSame = itsPairs.top().first;
+    const size_t almostLongest =
+        (duplication.longestSame * itsProximityFactor) / 100;
+
+    // The number of common characters with the worst bookmark is the
+    // smallest number for the pairs in between.
+    size_t first = worst;
+    while (itsPrevious[first] != NONE &&
+           itsSame[itsPrevious[first]] >= almostLongest)
+    {
+        first = itsPrevious[first];
+        refineGroupOf(first);
+        duplication.longestSame =
+            std::min(duplication.longestSame, itsSame[first]);
+    }
+    size_t last = itsNext[worst];
+    refineGroupOf(last);
+    while (itsNext[last] != NONE && itsSame[last] >= almostLongest)
+    {
+        duplication.longestSame =
+            std::min(duplication.longestSame, itsSame[last]);
+        last = itsNext[last];
+        refineGroupOf(last);
+    }
+
+    instances.clear();
+    for (size_t ix = first; ix != itsNext[last]; ix = itsNext[ix])
+        instances.push_back(ix);
+    duplication.instances          = instances.size();
+    duplication.indexOf1stInstance = first;
+
+    clearWithin(duplication, instances);
+    return true;
+}
+
+/**
+ * Adds the pair of a bookmark and the next one, or each run that it is in if
+ * runs are longer, unless they have too little in common.
+ */
+void RepeatEnumerator::addPair(size_t ix)
+{
+    for (size_t i = 1; i < itsMinInstances && ix != NONE;
+         ++i, ix = itsPrevious[ix])
+    {
+        const size_t same = runSame(ix);
+        if (same >= itsMinLength)
+            itsPairs.push(Pair(same, ix));
+    }
+}
+
+/**
+ * Returns the fewest common characters of the pairs in the run from a
+ * bookmark, or 0 if fewer bookmarks are left from it or they are all in the
+ * same part of the text.
+ */
+size_t RepeatEnumerator::runSame(size_t ix) const
+{
+    size_t same    = SIZE_MAX;
+    bool   isMixed = false;
+    for (size_t i = 1; i < itsMinInstances; ++i, ix = itsNext[ix])
+    {
+        if (itsNext[ix] == NONE)
+            return 0;
+        same    = std::min(same, itsSame[ix]);
+        isMixed = isMixed || itsContainer.isMixed(ix, itsNext[ix]);
+    }
+    return isMixed ? same : 0;
+}
+
+bool RepeatEnumerator::isLeft(size_t ix) const
+{
+    return itsLeftFrom[itsPositions[ix]] == itsPositions[ix];
+}
+
+/**
+ * Returns the second largest number of characters up to the end of the file
+ * among the bookmarks left in a group. No two of them can have more in
+ * common.
+ */
+size_t RepeatEnumerator::upperBound(size_t group) const
+{
+    size_t largest = 0;
+    size_t second  = 0;
+    for (size_t ix = itsGroupBegins[group]; ix < itsGroupEnds[group]; ++ix)
+        if (isLeft(ix))
+        {
+            const size_t offset = itsContainer.offset(ix);
+            const size_t toEof =
+                *std::lower_bound(itsEofs.begin(), itsEofs.end(), offset) -
+                offset;
+            if (toEof > largest)
+            {
+                second  = largest;
+                largest = toEof;
+            }
+            else if (toEof > second)
+                second = toEof;
+        }
+    return second;
+}
+
+void RepeatEnumerator::refineGroupOf(size_t ix)
+{
+    const size_t group =
+        std::upper_bound(itsGroupBegins.begin(), itsGroupBegins.end(), ix) -
+        itsGroupBegins.begin();
+    if (group > 0 && ix < itsGroupEnds[group - 1] && not itsRefined[group - 1])
+        refine(group - 1);
+}
+
+/**
+ * Sorts the bookmarks left in a group all the way and gives the pairs within
+ * it their real number of common characters. The bookmarks keep the indexes
+ * they had, so the links are still right, and the last one keeps its pair
+ * with the next group since all of them have as much in common with that.
+ */
+void RepeatEnumerator::refine(size_t group)
+{
+    itsRefined[group] = true;
+    std::vector<size_t> left;
+    for (size_t ix = itsGroupBegins[group]; ix < itsGroupEnds[group]; ++ix)
+        if (isLeft(ix))
+            left.push_back(ix);
+    if (left.size() < 2)
+        return;
+
+    // The bookmarks are spread over the same positions in text order as
+    // before, in the order of their offsets.
+    std::vector<size_t> positions(left.size());
+    for (size_t i = 0; i < left.size(); ++i)
+        positions[i] = itsPositions[left[i]];
+    std::sort(positions.begin(), positions.end());
+    std::vector<size_t> offsets(left.size());
+    for (size_t i = 0; i < left.size(); ++i)
+        offsets[i] = itsContainer.offset(itsByOffset[positions[i]]);
+
+    itsContainer.sortSubset(left, itsDepth);
+    for (size_t i = 0; i < left.size(); ++i)
+    {
+        const size_t position = positions[
+            std::lower_bound(offsets.begin(), offsets.end(),
+                             itsContainer.offset(left[i])) - offsets.begin()];
+        itsPositions[left[i]] = position;
+        itsByOffset[position] = left[i];
+    }
+
+    for (size_t i = 0; i + 1 < left.size(); ++i)
+    {
+        itsSame[left[i]] = itsContainer.nrOfSame(left[i], left[i + 1]);
+        addPair(left[i]);
+    }
+}
+
+
+/**
+ * Unlinks a bookmark, which must not be the last one in sorted order.
+ */
+void RepeatEnumerator::remove(size_t ix)
+{
+    const size_t previous = itsPrevious[ix];
+    const size_t next     = itsNext[ix];
+    if (previous != NONE)
+    {
+        // The runs that the previous one is in can change even if its pair
+        // keeps its common characters, and so can the parts of its pair.
+        itsNext[previous] = next;
+        if (itsSame[ix] < itsSame[previous] || itsMinInstances > 2 ||
+            itsContainer.isSeparated())
+        {
+            itsSame[previous] = std::min(itsSame[previous], itsSame[ix]);
+            addPair(previous);
+        }
+    }
+    itsPrevious[next] = previous;
+    itsNext[ix]       = NONE;
+    itsLeftFrom[itsPositions[ix]] = itsPositions[ix] + 1;
+}
+
+/**
+ * Returns the position in text order of the first bookmark that is left at
+ * or after the given position.
+ */
+size_t RepeatEnumerator::firstLeftFrom(size_t position)
+{
+    size_t result = position;
+    while (itsLeftFrom[result] != result)
+        result = itsLeftFrom[result];
+    while (itsLeftFrom[position] != result)
+    {
+        const size_t next = itsLeftFrom[position];
+        itsLeftFrom[position] = result;
+        position = next;
+    }
+    return result;
+}
+
+/**
+ * Removes the bookmarks that point to something within the duplication, just
+ * like BookmarkContainer::clearWithin(). That includes the quirk that the last
+ * bookmark in sorted order is never removed.
+ */
+void RepeatEnumerator::clearWithin(const Duplication&         duplication,
+                                   const std::vector<size_t>& instances)
+{
+    const size_t lastIx = itsNext.size() - 1;
+    const size_t size   = itsByOffset.size();
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        const size_t position = itsPositions[instances[i]];
+        // An instance that has been removed already doesn't remove anything.
+        if (itsLeftFrom[position] != position)
+            continue;
+        const size_t end = itsContainer.offset(instances[i]) +
+                           duplication.longestSame;
+        for (size_t p = position;
+             p < size && itsContainer.offset(itsByOffset[p]) < end;
+             p = firstLeftFrom(p + 1))
+        {
+            if (itsByOffset[p] != lastIx)
+                remove(itsByOffset[p]);
+        }
+    }
+}
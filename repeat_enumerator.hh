@@ -0,0 +1,101 @@
+#ifndef REPEAT_ENUMERATOR_HH
+#define REPEAT_ENUMERATOR_HH
+
+#include <cstdlib> // size_t
+#include <queue>
+#include <utility>
+#include <vector>
+
+class BookmarkContainer;
+struct Duplication;
+
+/**
+ * Finds the same duplications, in the same order, as repeatedly finding the
+ * worst duplication among the sorted bookmarks and clearing the bookmarks
+ * within it. This is done without a pass over all bookmarks per duplication.
+ *
+ * The number of common characters of each pair of neighbors in sorted order
+ * is computed once. The bookmarks that are left are linked together in sorted
+ * order. When one of them is removed, its two neighbors have as many common
+ * characters as the smaller of the two pairs it was part of. A heap then
+ * gives the pair with the most common characters, and the bookmarks within a
+ * reported area are found from their order in the processed text.
+ *
+ * The bookmarks need only be sorted by their first minLength characters. A
+ * group of bookmarks that are equal that far is sorted further only when it
+ * may hold the next duplication, or when a duplication reaches into it. Until
+ * then, the group is kept in a second heap with an upper bound on the common
+ * characters within it, which no pair can exceed since common characters end
+ * at the end of a file. Long duplicated areas are then mostly removed before
+ * anything within them has been sorted further.
+ *
+ * If a duplication must have more than two instances, the heap holds runs of
+ * that many neighbors instead of pairs, with the fewest common characters of
+ * the pairs in them.
+ */
+class RepeatEnumerator
+{
+public:
+    // The container must be sorted by at least the first minLength
+    // characters. It is sorted further as needed.
+    RepeatEnumerator(BookmarkContainer&       container,
+                     int                      minLength,
+                     int                      proximityFactor,
+                     int                      minInstances = 2);
+
+    /**
+     * Finds the next duplication and the sorted indexes of its instances, and
+     * removes the bookmarks within it. Returns false if there is no
+     * duplication of at least the minimum length left.
+     */
+    bool next(Duplication& duplication, std::vector<size_t>& instances);
+
+private:
+    typedef std::pair<size_t, size_t> Pair; // Common characters and index.
+
+    struct PairOrder
+    {
+        // The pair with the most common characters comes first, or the one
+        // that comes first in sorted order if there are several.
+        bool operator()(const Pair& a, const Pair& b) const
+        {
+            return a.first < b.first ||
+                (a.first == b.first && a.second > b.second);
+        }
+    };
+
+    void   addPair(size_t ix);
+    size_t runSame(size_t ix) const;
+    bool   isLeft(size_t ix) const;
+    size_t upperBound(size_t group) const;
+    void   refineGroupOf(size_t ix);
+    void   refine(size_t group);
+    void   remove(size_t ix);
+    size_t firstLeftFrom(size_t position);
+    void   clearWithin(const Duplication&         duplication,
+                       const std::vector<size_t>& instances);
+
+    BookmarkContainer&       itsContainer;
+    const size_t             itsMinLength;
+    const size_t             itsDepth;     // That the container is sorted by.
+    const int                itsProximityFactor;
+    const size_t             itsMinInstances;
+
+    std::vector<size_t> itsSame;      // Common characters with the next one.
+    std::vector<size_t> itsPrevious;  // Previous one left in sorted order.
+    std::vector<size_t> itsNext;      // Next one left in sorted order.
+    std::vector<size_t> itsByOffset;  // Sorted indexes in text order.
+    std::vector<size_t> itsPositions; // Position of each one in text order.
+    std::vector<size_t> itsLeftFrom;  // Leads to the next one left in text.
+    std::vector<size_t> itsEofs;      // Offsets of the ends of the files.
+
+    // Groups of two or more bookmarks that are equal as far as sorted.
+    std::vector<size_t> itsGroupBegins;
+    std::vector<size_t> itsGroupEnds;
+    std::vector<bool>   itsRefined;   // Is the group sorted all the way?
+
+    std::priority_queue<Pair, std::vector<Pair>, PairOrder> itsPairs;
+    std::priority_queue<Pair>                               itsGroups; // Bound.
+};
+
+#endif
@@ -0,0 +1,49 @@
+#include "sorted_run.hh"
+
+#include <cstdint>
+#include <iostream> // cerr
+
+// Exits the program, since nothing can be done without the temporary files.
+static void fail(const char* what)
+{
+    std::cerr << "dupfind: Could not " << what << " a temporary file.\n";
+    exit(EXIT_FAILURE);
+}
+
+SortedRun::SortedRun(): itsFile(tmpfile()), itsIsReading(false)
+{
+    if (itsFile == 0)
+        fail("create");
+}
+
+SortedRun::~SortedRun()
+{
+    fclose(itsFile);
+}
+
+void SortedRun::add(size_t offset)
+{
+    const uint64_t record = offset;
+    if (fwrite(&record, sizeof record, 1, itsFile) != 1)
+        fail("write");
+}
+
+bool SortedRun::next(size_t& offset)
+{
+    if (not itsIsReading)
+    {
+        if (fflush(itsFile) != 0)
+            fail("write");
+        rewind(itsFile);
+        itsIsReading = true;
+    }
+    uint64_t record;
+    if (fread(&record, sizeof record, 1, itsFile) != 1)
+    {
+        if (ferror(itsFile))
+            fail("read");
+        return false;
+    }
+    offset = record;
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef SORTED_RUN_HH
+#define SORTED_RUN_HH
+
+#include <cstdio> // FILE
+#include <cstdlib>
+
+/**
+ * A run of sorted bookmarks that is kept in a temporary file, which is
+ * removed when the run is destroyed. Each bookmark is stored as its offset
+ * into the processed text.
+ */
+class SortedRun
+{
+public:
+    SortedRun();
+    ~SortedRun();
+
+    void add(size_t offset);
+
+    // Reads the next bookmark, starting from the first one. Returns false
+    // when there are no more.
+    bool next(size_t& offset);
+
+private:
+    SortedRun(const SortedRun&) = delete;
+    SortedRun& operator=(const SortedRun&) = delete;
+
+    FILE* itsFile;
+    bool  itsIsReading;
+};
+
+#endif
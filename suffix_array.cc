@@ -0,0 +1,210 @@
+#include "suffix_array.hh"
+
+#include <algorithm> // fill
+#include <cstdint>
+
+namespace
+{
+
+/**
+ * The SA-IS algorithm on a string of n symbols below k, the last of which is
+ * the only smallest one. The strings on the recursive levels are stored
+ * within the suffix array of the level above.
+ */
+template <typename Symbol, typename Index>
+class SaIs
+{
+public:
+    static const Index EMPTY = Index(-1);
+
+    SaIs(const Symbol* s, Index* sa, size_t n, size_t k):
+        itsS(s), itsSa(sa), itsN(n), itsK(k), itsIsS(n), itsBuckets(k) {}
+
+    void run();
+
+private:
+    bool isLms(size_t i) const { return i > 0 && itsIsS[i] && !itsIsS[i - 1]; }
+
+    void findBuckets(bool ends);
+    void induce();
+
+    const Symbol*      itsS;
+    Index*             itsSa;
+    const size_t       itsN;
+    const size_t       itsK;
+    std::vector<bool>  itsIsS;     // Is the suffix smaller than the next one?
+    std::vector<Index> itsBuckets; // Next free slot for each symbol.
+};
+
+// Finds where the suffixes starting with each symbol begin or end.
+template <typename Symbol, typename Index>
+void SaIs<Symbol, Index>::findBuckets(bool ends)
+{
+    std::fill(itsBuckets.begin(), itsBuckets.end(), 0);
+    for (size_t i = 0; i < itsN; ++i)
+        ++itsBuckets[itsS[i]];
+    Index sum = 0;
+    for (size_t c = 0; c < itsK; ++c)
+    {
+        sum += itsBuckets[c];
+        itsBuckets[c] = ends ? sum : sum - itsBuckets[c];
+    }
+}
+
+// Sorts the L-type suffixes from the sorted LMS suffixes, and then the
+// S-type suffixes from those.
+template <typename Symbol, typename Index>
+void SaIs<Symbol, Index>::induce()
+{
+    findBuckets(false);
+    for (size_t i = 0; i < itsN; ++i)
+    {
+        const Index j = itsSa[i];
+        if (j != EMPTY && j > 0 && !itsIsS[j - 1])
+            itsSa[itsBuckets[itsS[j - 1]]++] = j - 1;
+    }
+    findBuckets(true);
+    for (size_t i = itsN; i-- > 0;)
+    {
+        const Index j = itsSa[i];
+        if (j != EMPTY && j > 0 && itsIsS[j - 1])
+            itsSa[--itsBuckets[itsS[j - 1]]] = j - 1;
+    }
+}
+
+template <typename Symbol, typename Index>
+void SaIs<Symbol, Index>::run()
+{
+    if (itsN == 1)
+    {
+        itsSa[0] = 0;
+        return;
+    }
+    itsIsS[itsN - 1] = true;
+    for (size_t i = itsN - 1; i-- > 0;)
+        itsIsS[i] = itsS[i] < itsS[i + 1] ||
+            (itsS[i] == itsS[i + 1] && itsIsS[i + 1]);
+
+    // Sort the LMS substrings by placing them at the ends of their buckets
+    // and inducing the rest.
+    findBuckets(true);
+    std::fill(itsSa, itsSa + itsN, EMPTY);
+    for (size_t i = 1; i < itsN; ++i)
+        if (isLms(i))
+            itsSa[--itsBuckets[itsS[i]]] = i;
+    induce();
+
+    // Move the sorted LMS substrings to the front and name them, with equal
+    // substrings getting the same name. No two LMS positions are adjacent,
+    // so the names fit in the second half, indexed by position / 2.
+    size_t n1 = 0;
+    for (size_t i = 0; i < itsN; ++i)
+        if (isLms(itsSa[i]))
+            itsSa[n1++] = itsSa[i];
+    std::fill(itsSa + n1, itsSa + itsN, EMPTY);
+    size_t name     = 0;
+    Index  previous = EMPTY;
+    for (size_t i = 0; i < n1; ++i)
+    {
+        const Index position = itsSa[i];
+        bool        differs  = false;
+        for (size_t d = 0; d < itsN; ++d)
+            if (previous == EMPTY ||
+                itsS[position + d] != itsS[previous + d] ||
+                itsIsS[position + d] != itsIsS[previous + d])
+            {
+                differs = true;
+                break;
+            }
+            else if (d > 0 && (isLms(position + d) || isLms(previous + d)))
+                break;
+        if (differs)
+        {
+            ++name;
+            previous = position;
+        }
+        itsSa[n1 + position / 2] = name - 1;
+    }
+    for (size_t i = itsN, j = itsN; i-- > n1;)
+        if (itsSa[i] != EMPTY)
+            itsSa[--j] = itsSa[i];
+
+    // Sort the LMS suffixes by sorting the string of names, recursively if
+    // there are equal names.
+    Index* s1 = itsSa + itsN - n1;
+    if (name < n1)
+        SaIs<Index, Index>(s1, itsSa, n1, name).run();
+    else
+        for (size_t i = 0; i < n1; ++i)
+            itsSa[s1[i]] = i;
+
+    // Place the sorted LMS suffixes at the ends of their buckets, in reverse
+    // order so that the order is kept, and induce the rest.
+    for (size_t i = 1, j = 0; i < itsN; ++i)
+        if (isLms(i))
+            s1[j++] = i;
+    for (size_t i = 0; i < n1; ++i)
+        itsSa[i] = s1[itsSa[i]];
+    std::fill(itsSa + n1, itsSa + itsN, EMPTY);
+    findBuckets(true);
+    for (size_t i = n1; i-- > 0;)
+    {
+        const Index j = itsSa[i];
+        itsSa[i] = EMPTY;
+        itsSa[--itsBuckets[itsS[j]]] = j;
+    }
+    induce();
+}
+
+} // namespace
+
+template <typename Index>
+void buildSuffixArray(const char* text, size_t n, std::vector<Index>& sa)
+{
+    sa.assign(n, 0);
+    if (n == 0)
+        return;
+    const unsigned char* s = reinterpret_cast<const unsigned char*>(text);
+    SaIs<unsigned char, Index>(s, &sa[0], n, 256).run();
+}
+
+template <typename Index>
+void buildPermutedLcp(const char*               text,
+                      const std::vector<Index>& sa,
+                      std::vector<Index>&       plcp)
+{
+    // Each suffix is first given the position of the one before it. Then the
+    // common characters are counted in text order, where each suffix has at
+    // most one less in common with its predecessor than the one before.
+    const Index none = Index(-1);
+    plcp.assign(sa.size(), none);
+    for (size_t i = 1; i < sa.size(); ++i)
+        plcp[sa[i]] = sa[i - 1];
+
+    size_t same = 0;
+    for (size_t position = 0; position < plcp.size(); ++position)
+    {
+        const Index previous = plcp[position];
+        if (previous == none)
+        {
+            plcp[position] = 0;
+            same           = 0;
+            continue;
+        }
+        // The null character at the end is unique, so the loop stops.
+        while (text[position + same] == text[previous + same])
+            ++same;
+        plcp[position] = same;
+        if (same > 0)
+            --same;
+    }
+}
+
+template void buildSuffixArray(const char*, size_t, std::vector<uint32_t>&);
+template void buildSuffixArray(const char*, size_t, std::vector<uint64_t>&);
+template void buildPermutedLcp(const char*,
+                               const std::vector<uint32_t>&,
+                               std::vector<uint32_t>&);
+template void buildPermutedLcp(const char*,
+                               const std::vector<uint64_t>&,
+                               std::vector<uint64_t>&);
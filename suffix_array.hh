@@ -0,0 +1,27 @@
+#ifndef SUFFIX_ARRAY_HH
+#define SUFFIX_ARRAY_HH
+
+#include <cstdlib> // size_t
+#include <vector>
+
+/**
+ * Sorts all suffixes of a text of n characters in ascending order, in time
+ * linear in n no matter how repetitive the text is. The last character must
+ * be the only null character. The SA-IS algorithm by Nong, Zhang and Chan is
+ * used. Index must be able to hold n.
+ */
+template <typename Index>
+void buildSuffixArray(const char* text, size_t n, std::vector<Index>& sa);
+
+/**
+ * Gives the number of common characters of each suffix and the one before it
+ * in the suffix array, or 0 for the first one, indexed by the position of the
+ * suffix in the text. Karkkainen's Phi algorithm is used, which also takes
+ * linear time.
+ */
+template <typename Index>
+void buildPermutedLcp(const char*               text,
+                      const std::vector<Index>& sa,
+                      std::vector<Index>&       plcp);
+
+#endif
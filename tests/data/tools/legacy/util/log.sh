@@ -0,0 +1,28 @@
+# Logging helpers shared by the build scripts.
+
+log_level=${LOG_LEVEL:-info}
+
+log_timestamp() {
+    date '+%Y-%m-%d %H:%M:%S'
+}
+
+log_message() {
+    level=$1
+    shift
+    echo "$(log_timestamp) [$level] $*" >&2
+}
+
+log_info() {
+    if [ "$log_level" != "quiet" ]; then
+        log_message INFO "$@"
+    fi
+}
+
+log_error() {
+    log_message ERROR "$@"
+}
+
+die() {
+    log_error "$@"
+    exit 1
+}
@@ -0,0 +1,55 @@
+#!/bin/sh
+#
+# Runs dupfind on more than 4 GB of text, where offsets no longer fit in 32
+# bits, and checks that a block of lines planted near the beginning and at the
+# very end is reported with the right file names and line numbers.
+#
+# Usage: stress.sh <dupfind> [<total MB> [<work dir>]]
+#
+# The default is 4500 MB of text. Dupfind then needs about 14 GB of memory, and
+# the work dir needs as much disk as the text.
+
+PROGRAM=$1
+TOTAL_MB=${2:-4500}
+WORK_DIR=${3:-/tmp/dupfind-stress}
+NR_OF_FILES=9
+LINE_LENGTH=1000
+
+set -e
+rm -rf "$WORK_DIR"
+mkdir -p "$WORK_DIR"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+# Lines of random letters and digits, which are unlikely to have anything but
+# short prefixes in common. The characters + and / are replaced so that no
+# comments are found.
+random_lines()
+{
+    head -c "$1" /dev/urandom | base64 -w $LINE_LENGTH | tr '+/' 'xy'
+}
+
+cd "$WORK_DIR"
+random_lines 5000 | head -5 > block.txt
+bytes_per_file=$((TOTAL_MB * 1024 * 1024 / NR_OF_FILES * 3 / 4))
+last=$((NR_OF_FILES - 1))
+for i in $(seq 0 $last); do
+    {
+        if [ $i -eq 0 ]; then random_lines 100; cat block.txt; fi
+        random_lines $bytes_per_file
+    } > big$i.cpp
+done
+last_line=$(($(wc -l < big$last.cpp) + 1))
+cat block.txt >> big$last.cpp
+rm block.txt
+
+echo "$(du -sh . | cut -f1) in $NR_OF_FILES files"
+"$PROGRAM" -1 -e .cpp > output.txt
+
+length=$((5 * LINE_LENGTH))
+cat > expected.txt <<EOF
+./big0.cpp:2:Duplication 1 (1st instance, $length characters, 5 lines).
+./big$last.cpp:$last_line:Duplication 1 (2nd instance).
+
+EOF
+diff expected.txt output.txt
+echo OK
@@ -0,0 +1,72 @@
+
+  function resumeMountClassInstance(
+    workInProgress: Fiber,
+    renderExpirationTime: ExpirationTime,
+  ): boolean {
+    const ctor = workInProgress.type;
+    const instance = workInProgress.stateNode;
+    resetInputPointers(workInProgress, instance);
+
+    const oldProps = workInProgress.memoizedProps;
+    const newProps = workInProgress.pendingProps;
+    const oldContext = instance.context;
+    const newUnmaskedContext = getUnmaskedContext(workInProgress);
+    const newContext = getMaskedContext(workInProgress, newUnmaskedContext);
+
+    const hasNewLifecycles =
+      typeof ctor.getDerivedStateFromProps === 'function' ||
+      typeof instance.getSnapshotBeforeUpdate === 'function';
+
+    // Note: During these life-cycles, instance.props/instance.state are what
+    // ever the previously attempted to render - not the "current". However,
+    // during componentDidUpdate we pass the "current" props.
+
+    // In order to support react-lifecycles-compat polyfilled components,
+    // Unsafe lifecycles should not be invoked for components using the new APIs.
+    if (
+      !hasNewLifecycles &&
+      (typeof instance.UNSAFE_componentWillReceiveProps === 'function' ||
+        typeof instance.componentWillReceiveProps === 'function')
+    ) {
+      if (oldProps !== newProps || oldContext !== newContext) {
+        callComponentWillReceiveProps(
+          workInProgress,
+          instance,
+          newProps,
+          newContext,
+        );
+      }
+    }
+
+    // Compute the next state using the memoized state and the update queue.
+    const oldState = workInProgress.memoizedState;
+    // TODO: Previous state can be null.
+    let newState;
+    let derivedStateFromCatch;
+    if (workInProgress.updateQueue !== null) {
+  REFERENCES_REGEX = /^[A-ZÅÄÖa-zåäö0-9\s!\-+%"/?,.§]*$/g;
+
+  constructor(props) {
+    super(props);
+    const { kettleData } = props;
+
+    this.state = this.clearState(kettleData.referenceId);
+
+    this.storeTransaction = this.storeTransaction.bind(this);
+    this.onChange = this.onChange.bind(this);
+    this.mapStateToTransactionType = this.mapStateToTransactionType.bind(this);
+    this.checkRequiredFields = this.checkRequiredFields.bind(this);
+    props.setTransactionIsDirty(false);
+  }
+
+  // Allow only: A-Ö a-ö 0-9 & . : ; - + / * = > < ( ) %
+  ALPHA_NUMERIC_REGEX = /^[A-ZÅÄÖa-zåäö0-9\s&.:;\-+/*=><()%]*$/g;
+
+  constructor(props) {
+    super(props);
+    const { kettleData } = props;
+
+    this.state = this.clearState(kettleData.referenceId);
+
+    this.storeTransaction = this.storeTransaction.bind(this);
+    this.onChange = this.onChange.bind(this);
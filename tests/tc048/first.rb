@@ -0,0 +1,5 @@
+def total(items)
+  sum = 0
+  items.each { |item| sum += item.price * item.count }
+  sum
+end
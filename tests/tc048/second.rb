@@ -0,0 +1,7 @@
+class Order
+  def total(items)
+    sum = 0
+    items.each { |item| sum += item.price * item.count }
+    sum
+  end
+end
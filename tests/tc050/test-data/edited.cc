@@ -0,0 +1,39 @@
+#include "report.hh"
+
+// Sums up the orders of one customer and writes a summary.
+void summarizeOrders(const Customer& customer, Report& report)
+{
+    double total    = 0;
+    int    nrOfOpen = 0;
+    for (size_t i = 0; i < customer.orders.size(); ++i)
+    {
+        const Order& order = customer.orders[i];
+        total += order.price * order.quantity;
+        if (order.status == Order::OPEN)
+            ++nrOfOpen;
+    }
+    report.addLine("Customer: " + customer.name);
+    report.addLine("Number of orders: " + toString(customer.orders.size()));
+    report.addLine("Open orders: " + toString(nrOfOpen));
+    report.addLine("Total: " + formatMoney(total));
+    report.addSeparator();
+}
+
+// Sums up the orders of one supplier and writes a summary.
+void summarizeDeliveries(const Supplier& supplier, Report& report)
+{
+    double total    = 0;
+    int    nrOfOpen = 0;
+    for (size_t i = 0; i < supplier.orders.size(); ++i)
+    {
+        const Order& order = supplier.orders[i];
+        total += order.price * order.quantity * (1 - order.discount);
+        if (order.status == Order::OPEN)
+            ++nrOfOpen;
+    }
+    report.addLine("Supplier: " + supplier.name);
+    report.addLine("Number of orders: " + toString(supplier.orders.size()));
+    report.addLine("Open orders: " + toString(nrOfOpen));
+    report.addLine("Total: " + formatMoney(total));
+    report.addSeparator();
+}
@@ -0,0 +1,37 @@
+# Number helpers for the build scripts.
+
+num_is_integer() {
+    case "$1" in
+        ''|*[!0-9-]*) return 1 ;;
+        -) return 1 ;;
+        *) return 0 ;;
+    esac
+}
+
+num_max() {
+    if [ "$1" -gt "$2" ]; then
+        echo "$1"
+    else
+        echo "$2"
+    fi
+}
+
+num_min() {
+    if [ "$1" -lt "$2" ]; then
+        echo "$1"
+    else
+        echo "$2"
+    fi
+}
+
+num_clamp() {
+    num_min "$(num_max "$1" "$2")" "$3"
+}
+
+num_percent() {
+    if [ "$2" -eq 0 ]; then
+        echo 0
+    else
+        echo $(( (100 * $1 + $2 / 2) / $2 ))
+    fi
+}
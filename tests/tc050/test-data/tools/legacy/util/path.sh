@@ -0,0 +1,35 @@
+# Path helpers for the build scripts.
+
+path_dir() {
+    case "$1" in
+        */*) printf '%s' "${1%/*}" ;;
+        *) printf '.' ;;
+    esac
+}
+
+path_base() {
+    printf '%s' "${1##*/}"
+}
+
+path_ext() {
+    base=$(path_base "$1")
+    case "$base" in
+        *.*) printf '%s' "${base##*.}" ;;
+        *) printf '' ;;
+    esac
+}
+
+path_join() {
+    if [ -z "$1" ]; then
+        printf '%s' "$2"
+    else
+        printf '%s/%s' "${1%/}" "${2#/}"
+    fi
+}
+
+path_is_absolute() {
+    case "$1" in
+        /*) return 0 ;;
+        *) return 1 ;;
+    esac
+}
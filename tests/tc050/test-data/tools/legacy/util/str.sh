@@ -0,0 +1,34 @@
+# String helpers that work in any POSIX shell.
+
+str_trim() {
+    printf '%s' "$1" | sed -e 's/^[[:space:]]*//' -e 's/[[:space:]]*$//'
+}
+
+str_lower() {
+    printf '%s' "$1" | tr '[:upper:]' '[:lower:]'
+}
+
+
+str_starts_with() {
+    case "$1" in
+        "$2"*) return 0 ;;
+        *) return 1 ;;
+    esac
+}
+
+str_ends_with() {
+    case "$1" in
+        *"$2") return 0 ;;
+        *) return 1 ;;
+    esac
+}
+
+str_times() {
+    count=$2
+    result=
+    while [ "$count" -gt 0 ]; do
+        result="${result}$1"
+        count=$((count - 1))
+    done
+    printf '%s' "$result"
+}
@@ -0,0 +1,10001 @@
+/* Generated, with nothing but the same short line. */
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
+0;
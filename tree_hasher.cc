@@ -0,0 +1,371 @@
+#include "tree_hasher.hh"
+#include "bookmark.hh"
+#include "file.hh" // SPECIAL_EOF
+
+#include <algorithm> // binary_search, min, sort, swap
+#include <cstring>   // strchr
+#include <iterator>  // next
+
+static const size_t NONE = SIZE_MAX;
+
+// For the FNV-1a hashes of the files and the directories.
+static const uint64_t HASH_BASE        = 0x100000001b3ULL;
+static const uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+static uint64_t addToHash(uint64_t hash, const std::string& name)
+{
+    for (size_t i = 0; i < name.length(); ++i)
+        hash = (hash ^ (unsigned char)name[i]) * HASH_BASE;
+    return hash;
+}
+
+static uint64_t addToHash(uint64_t hash, uint64_t value)
+{
+    for (int byte = 0; byte < 8; ++byte)
+        hash = (hash ^ ((value >> (8 * byte)) & 0xff)) * HASH_BASE;
+    return hash;
+}
+
+static std::string baseName(const std::string& name)
+{
+    return name.substr(name.rfind('/') + 1);
+}
+
+TreeHasher::TreeHasher(const char* processedText, double minSimilarity)
+{
+    size_t begin = 0;
+    for (const char* eof = strchr(processedText, SPECIAL_EOF); eof != 0;
+         eof = strchr(eof + 1, SPECIAL_EOF))
+    {
+        const size_t end  = eof - processedText;
+        uint64_t     hash = FNV_OFFSET_BASIS;
+        for (size_t i = begin; i < end; ++i)
+            hash = (hash ^ (unsigned char)processedText[i]) * HASH_BASE;
+        itsFileBegins.push_back(begin);
+        itsFileEnds.push_back(end);
+        itsFileHashes.push_back(hash);
+        begin = end + 1;
+    }
+
+    // Files without any code, e.g., with only comments, are all alike.
+    itsFileDirectories.assign(itsFileHashes.size(), NONE);
+    for (size_t file = 0; file < itsFileHashes.size(); ++file)
+        if (itsFileEnds[file] > itsFileBegins[file])
+        {
+            const std::string& name  = Bookmark::fileName(file);
+            const size_t       slash = name.rfind('/');
+            const size_t       dir   = directoryOf(
+                (slash == std::string::npos) ? "" : name.substr(0, slash));
+            itsDirectories[dir].files.push_back(file);
+            itsFileDirectories[file] = dir;
+        }
+
+    hashDirectories();
+    itsIsReported.assign(itsDirectories.size(), false);
+    itsIsCopied.assign(itsDirectories.size(), false);
+    itsIsCopiedFile.assign(itsFileHashes.size(), false);
+    findExactCopies();
+    findNearCopies(minSimilarity);
+}
+
+std::vector<std::pair<size_t, size_t> > TreeHasher::copiedFiles() const
+{
+    std::vector<std::pair<size_t, size_t> > result;
+    for (size_t file = 0; file < itsIsCopiedFile.size(); ++file)
+        if (itsIsCopiedFile[file])
+            result.push_back(std::make_pair(itsFileBegins[file],
+                                            itsFileEnds[file]));
+    return result;
+}
+
+// Returns the directory with the given name, which is added if it's new.
+size_t TreeHasher::directoryOf(const std::string& name)
+{
+    const auto found = itsIndex.find(name);
+    if (found != itsIndex.end())
+        return found->second;
+
+    Directory dir;
+    dir.name   = name;
+    dir.parent = NONE;
+    dir.depth  = 0;
+    dir.hash   = 0;
+    const size_t slash = name.rfind('/');
+    if (slash != std::string::npos)
+    {
+        dir.parent = directoryOf(name.substr(0, slash));
+        dir.depth  = itsDirectories[dir.parent].depth + 1;
+    }
+    itsDirectories.push_back(dir);
+    const size_t ix = itsDirectories.size() - 1;
+    itsIndex[name] = ix;
+    if (dir.parent != NONE)
+        itsDirectories[dir.parent].children.push_back(ix);
+    return ix;
+}
+
+/**
+ * Hashes the names and hashes of the entries of each directory, deepest
+ * first, so that the hashes of its subdirectories are known.
+ */
+void TreeHasher::hashDirectories()
+{
+    std::vector<size_t> order;
+    for (size_t dir = 0; dir < itsDirectories.size(); ++dir)
+        order.push_back(dir);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return itsDirectories[a].depth > itsDirectories[b].depth;
+    });
+
+    for (size_t o = 0; o < order.size(); ++o)
+    {
+        Directory& dir = itsDirectories[order[o]];
+        std::vector<std::pair<std::string, uint64_t> > entries;
+        for (size_t f = 0; f < dir.files.size(); ++f)
+        {
+            const size_t file = dir.files[f];
+            entries.push_back(std::make_pair(baseName(Bookmark::fileName(file)),
+                                             itsFileHashes[file]));
+            dir.allFiles.push_back(file);
+        }
+        for (size_t c = 0; c < dir.children.size(); ++c)
+        {
+            const Directory& sub = itsDirectories[dir.children[c]];
+            entries.push_back(std::make_pair(baseName(sub.name) + "/",
+                                             sub.hash));
+            dir.allFiles.insert(dir.allFiles.end(), sub.allFiles.begin(),
+                                sub.allFiles.end());
+        }
+        std::sort(entries.begin(), entries.end());
+        dir.hash = FNV_OFFSET_BASIS;
+        for (size_t e = 0; e < entries.size(); ++e)
+            dir.hash = addToHash(addToHash(dir.hash, entries[e].first),
+                                 entries[e].second);
+    }
+}
+
+/**
+ * Reports the directories with the same hash, the ones with the most files
+ * first. Copies within a reported directory are left out, since the copy of
+ * the directory covers them.
+ */
+void TreeHasher::findExactCopies()
+{
+    std::vector<size_t> candidates;
+    for (size_t dir = 0; dir < itsDirectories.size(); ++dir)
+        if (itsDirectories[dir].allFiles.size() >= MIN_FILES)
+            candidates.push_back(dir);
+    std::sort(candidates.begin(), candidates.end(), [&](size_t a, size_t b) {
+        const Directory& dirA = itsDirectories[a];
+        const Directory& dirB = itsDirectories[b];
+        if (dirA.allFiles.size() != dirB.allFiles.size())
+            return dirA.allFiles.size() > dirB.allFiles.size();
+        if (dirA.hash != dirB.hash)
+            return dirA.hash < dirB.hash;
+        return dirA.name < dirB.name;
+    });
+
+    for (size_t begin = 0; begin < candidates.size();)
+    {
+        size_t end = begin + 1;
+        while (end < candidates.size() &&
+               itsDirectories[candidates[end]].hash ==
+                   itsDirectories[candidates[begin]].hash)
+        {
+            ++end;
+        }
+        std::vector<size_t> dirs;
+        for (size_t c = begin; c < end; ++c)
+            if (not isWithin(candidates[c], itsIsReported))
+                dirs.push_back(candidates[c]);
+        if (dirs.size() >= 2)
+            addCopy(dirs, 1);
+        begin = end;
+    }
+}
+
+/**
+ * Reports the pairs of directories that have at least the given share of
+ * their files in common, the ones with the most common files first. The
+ * common files are counted for all pairs at once, from the directories above
+ * each group of files with the same hash. A directory whose files are all in
+ * one subdirectory is passed through, so that the pair is reported for the
+ * subdirectory instead.
+ */
+void TreeHasher::findNearCopies(double minSimilarity)
+{
+    std::vector<size_t> nrOfLeft;
+    std::vector<bool>   isPassedThrough;
+    countLeft(nrOfLeft, isPassedThrough);
+
+    std::vector<size_t> files;
+    for (size_t file = 0; file < itsFileHashes.size(); ++file)
+        if (itsFileDirectories[file] != NONE && not itsIsCopiedFile[file])
+            files.push_back(file);
+    std::sort(files.begin(), files.end(), [&](size_t a, size_t b) {
+        return itsFileHashes[a] < itsFileHashes[b];
+    });
+
+    std::map<std::pair<size_t, size_t>, size_t> nrOfShared;
+    for (size_t begin = 0; begin < files.size();)
+    {
+        size_t end = begin + 1;
+        while (end < files.size() &&
+               itsFileHashes[files[end]] == itsFileHashes[files[begin]])
+        {
+            ++end;
+        }
+        if (end - begin >= 2 && end - begin <= MAX_FILES_PER_HASH)
+        {
+            std::map<size_t, size_t> counts; // Of the files below each one.
+            for (size_t f = begin; f < end; ++f)
+                for (size_t dir = itsFileDirectories[files[f]]; dir != NONE;
+                     dir = itsDirectories[dir].parent)
+                {
+                    if (not isPassedThrough[dir])
+                        ++counts[dir];
+                }
+            for (auto a = counts.begin(); a != counts.end(); ++a)
+                for (auto b = std::next(a); b != counts.end(); ++b)
+                    if (not isAbove(a->first, b->first) &&
+                        not isAbove(b->first, a->first))
+                    {
+                        nrOfShared[std::make_pair(a->first, b->first)] +=
+                            std::min(a->second, b->second);
+                    }
+        }
+        begin = end;
+    }
+
+    struct Pair
+    {
+        size_t first;
+        size_t second;
+        size_t nrOfShared;
+        double similarity;
+    };
+    std::vector<Pair> pairs;
+    for (auto it = nrOfShared.begin(); it != nrOfShared.end(); ++it)
+    {
+        Pair pair;
+        pair.first      = it->first.first;
+        pair.second     = it->first.second;
+        pair.nrOfShared = it->second;
+        const size_t nrOfFirst  = nrOfLeft[pair.first];
+        const size_t nrOfSecond = nrOfLeft[pair.second];
+        if (nrOfFirst < MIN_FILES || nrOfSecond < MIN_FILES)
+            continue;
+        pair.similarity = double(pair.nrOfShared) /
+                          (nrOfFirst + nrOfSecond - pair.nrOfShared);
+        if (pair.similarity >= minSimilarity)
+            pairs.push_back(pair);
+    }
+    std::sort(pairs.begin(), pairs.end(), [&](const Pair& a, const Pair& b) {
+        if (a.nrOfShared != b.nrOfShared)
+            return a.nrOfShared > b.nrOfShared;
+        if (a.similarity != b.similarity)
+            return a.similarity > b.similarity;
+        return itsDirectories[a.first].name < itsDirectories[b.first].name;
+    });
+
+    for (size_t p = 0; p < pairs.size(); ++p)
+    {
+        if (isWithin(pairs[p].first, itsIsReported) &&
+            isWithin(pairs[p].second, itsIsReported))
+        {
+            continue;
+        }
+        std::vector<size_t> dirs;
+        dirs.push_back(pairs[p].first);
+        dirs.push_back(pairs[p].second);
+        // The original must not be a copy itself, or its files would be
+        // left out twice.
+        if (itsDirectories[dirs[1]].name < itsDirectories[dirs[0]].name)
+            std::swap(dirs[0], dirs[1]);
+        if (isWithin(dirs[0], itsIsCopied))
+            std::swap(dirs[0], dirs[1]);
+        addCopy(dirs, pairs[p].similarity);
+    }
+}
+
+/**
+ * Counts the files in or below each directory that aren't copies, and finds
+ * the directories where all of them are in one subdirectory.
+ */
+void TreeHasher::countLeft(std::vector<size_t>& nrOfLeft,
+                           std::vector<bool>&   isPassedThrough) const
+{
+    nrOfLeft.assign(itsDirectories.size(), 0);
+    for (size_t dir = 0; dir < itsDirectories.size(); ++dir)
+    {
+        const std::vector<size_t>& files = itsDirectories[dir].allFiles;
+        for (size_t f = 0; f < files.size(); ++f)
+            if (not itsIsCopiedFile[files[f]])
+                ++nrOfLeft[dir];
+    }
+
+    isPassedThrough.assign(itsDirectories.size(), false);
+    for (size_t dir = 0; dir < itsDirectories.size(); ++dir)
+    {
+        const std::vector<size_t>& children = itsDirectories[dir].children;
+        size_t                     nrOfUsed = 0;
+        size_t                     inUsed   = 0;
+        for (size_t c = 0; c < children.size(); ++c)
+            if (nrOfLeft[children[c]] > 0)
+            {
+                ++nrOfUsed;
+                inUsed += nrOfLeft[children[c]];
+            }
+        isPassedThrough[dir] = nrOfUsed == 1 && inUsed == nrOfLeft[dir];
+    }
+}
+
+// Is the directory or one above it marked?
+bool TreeHasher::isWithin(size_t dir, const std::vector<bool>& marked) const
+{
+    for (; dir != NONE; dir = itsDirectories[dir].parent)
+        if (marked[dir])
+            return true;
+    return false;
+}
+
+bool TreeHasher::isAbove(size_t upper, size_t lower) const
+{
+    for (; lower != NONE; lower = itsDirectories[lower].parent)
+        if (lower == upper)
+            return true;
+    return false;
+}
+
+void TreeHasher::addCopy(const std::vector<size_t>& dirs, double similarity)
+{
+    Copy copy;
+    for (size_t d = 0; d < dirs.size(); ++d)
+    {
+        const std::string& name = itsDirectories[dirs[d]].name;
+        copy.directories.push_back(name.empty() ? "." : name);
+        itsIsReported[dirs[d]] = true;
+        if (d > 0)
+            itsIsCopied[dirs[d]] = true;
+    }
+    copy.nrOfFiles  = itsDirectories[dirs[0]].allFiles.size();
+    copy.similarity = similarity;
+    itsCopies.push_back(copy);
+
+    // The files in the copies that are the same as in the original.
+    const std::vector<size_t>& original = itsDirectories[dirs[0]].allFiles;
+    std::vector<uint64_t>      hashes;
+    for (size_t f = 0; f < original.size(); ++f)
+        hashes.push_back(itsFileHashes[original[f]]);
+    std::sort(hashes.begin(), hashes.end());
+    for (size_t d = 1; d < dirs.size(); ++d)
+    {
+        const std::vector<size_t>& copied = itsDirectories[dirs[d]].allFiles;
+        for (size_t f = 0; f < copied.size(); ++f)
+            if (std::binary_search(hashes.begin(), hashes.end(),
+                                   itsFileHashes[copied[f]]))
+            {
+                itsIsCopiedFile[copied[f]] = true;
+            }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef TREE_HASHER_HH
+#define TREE_HASHER_HH
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility> // pair
+#include <vector>
+
+/**
+ * Finds directories that are copies of each other, e.g., a library that is
+ * vendored into several components, so that they can be reported as one
+ * fact instead of as the many duplications between their files.
+ *
+ * Each file gets a hash of its processed text, and each directory a hash of
+ * the names and hashes of its entries, from the bottom up like in a Merkle
+ * tree. Directories with the same hash are exact copies. Directories that
+ * share most of their file hashes, counted through an index from each file
+ * hash to the directories above the files that have it, are near copies.
+ * Only the topmost copies are reported, and the files in the copies that
+ * are the same as in the originals don't count for the near copies. This
+ * takes about linear time in the size of the text, so it's cheap next to
+ * finding the duplications.
+ */
+class TreeHasher
+{
+public:
+    struct Copy
+    {
+        std::vector<std::string> directories; // The original first.
+        size_t                   nrOfFiles;   // In the original.
+        double                   similarity;  // Of the file hashes.
+    };
+
+    // The text holds the processed files, each ended by SPECIAL_EOF.
+    TreeHasher(const char* processedText, double minSimilarity);
+
+    // Directories with fewer files than this are not reported.
+    static const size_t MIN_FILES = 2;
+
+    // A file hash that more files than this have is mostly boilerplate and
+    // doesn't make directories near copies.
+    static const size_t MAX_FILES_PER_HASH = 50;
+
+    // The exact copies first, then the near ones, each by their size.
+    const std::vector<Copy>& copies() const { return itsCopies; }
+
+    /**
+     * Returns where the files that are in a copy, and that are the same as a
+     * file in its original, are in the processed text, in text order.
+     */
+    std::vector<std::pair<size_t, size_t> > copiedFiles() const;
+
+private:
+    struct Directory
+    {
+        std::string         name;
+        size_t              parent;
+        size_t              depth;
+        std::vector<size_t> files;    // Directly in it.
+        std::vector<size_t> children;
+        std::vector<size_t> allFiles; // Also in its subdirectories.
+        uint64_t            hash;
+    };
+
+    size_t directoryOf(const std::string& name);
+    void   hashDirectories();
+    void   findExactCopies();
+    void   findNearCopies(double minSimilarity);
+    void   countLeft(std::vector<size_t>& nrOfLeft,
+                     std::vector<bool>&   isPassedThrough) const;
+    bool   isWithin(size_t dir, const std::vector<bool>& marked) const;
+    bool   isAbove(size_t upper, size_t lower) const;
+    void   addCopy(const std::vector<size_t>& dirs, double similarity);
+
+    std::vector<size_t>               itsFileBegins; // In the processed text.
+    std::vector<size_t>               itsFileEnds;
+    std::vector<uint64_t>             itsFileHashes;
+    std::vector<size_t>               itsFileDirectories;
+    std::vector<Directory>            itsDirectories;
+    std::map<std::string, size_t>     itsIndex;      // Of each directory.
+    std::vector<bool>                 itsIsReported; // In a copy.
+    std::vector<bool>                 itsIsCopied;   // Not the original.
+    std::vector<bool>                 itsIsCopiedFile;
+    std::vector<Copy>                 itsCopies;
+};
+
+#endif
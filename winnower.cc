@@ -0,0 +1,350 @@
+#include "winnower.hh"
+#include "bookmark_container.hh"
+#include "file.hh" // SPECIAL_EOF
+#include "interval_set.hh"
+
+#include <algorithm> // max, min, sort, stable_sort, swap
+#include <cstring>   // strncmp
+#include <deque>
+#include <map>
+#include <queue>     // priority_queue
+#include <utility>   // move
+
+static const size_t NONE = SIZE_MAX;
+
+// For the rolling hash of the k-grams.
+static const uint64_t HASH_BASE = 0x100000001b3ULL;
+
+Winnower::Winnower(const BookmarkContainer& container,
+                   size_t                   minLength,
+                   size_t                   minInstances):
+    itsContainer(container),
+    itsMinLength(std::max<size_t>(minLength, 1)),
+    itsMinInstances(minInstances),
+    itsKgramLength(std::min(KGRAM_LENGTH, itsMinLength)),
+    itsWindowLength(itsMinLength - itsKgramLength + 1),
+    itsNrOfFingerprints(0)
+{
+    std::vector<Fingerprint> table = fingerprints();
+    itsNrOfFingerprints = table.size();
+    std::sort(table.begin(), table.end(),
+              [](const Fingerprint& a, const Fingerprint& b) {
+                  return a.hash < b.hash ||
+                      (a.hash == b.hash && a.offset < b.offset);
+              });
+
+    std::vector<Match> pairs;
+    for (size_t begin = 0; begin < table.size();)
+    {
+        size_t end = begin + 1;
+        while (end < table.size() && table[end].hash == table[begin].hash)
+            ++end;
+        // Text that is found at fewer places selects no fingerprint at more.
+        if (end - begin >= itsMinInstances)
+            addPairs(table, begin, end, pairs);
+        begin = end;
+    }
+    std::vector<Fingerprint>().swap(table);
+    expand(pairs);
+}
+
+std::vector<Winnower::Clone> Winnower::clones() const
+{
+    std::vector<Match> matches = itsMatches;
+    std::sort(matches.begin(), matches.end(),
+              [](const Match& a, const Match& b) {
+                  if (a.length != b.length)
+                      return a.length > b.length;
+                  return a.first < b.first ||
+                      (a.first == b.first && a.second < b.second);
+              });
+
+    // Matches of the same length that share an instance have the same text,
+    // so they are joined into one clone.
+    std::vector<Clone> candidates;
+    for (size_t begin = 0; begin < matches.size();)
+    {
+        size_t end = begin + 1;
+        while (end < matches.size() &&
+               matches[end].length == matches[begin].length)
+        {
+            ++end;
+        }
+        std::map<size_t, size_t> parents;
+        auto root = [&](size_t offset) {
+            while (parents[offset] != offset)
+                offset = parents[offset] = parents[parents[offset]];
+            return offset;
+        };
+        for (size_t m = begin; m < end; ++m)
+        {
+            parents.insert(std::make_pair(matches[m].first, matches[m].first));
+            parents.insert(std::make_pair(matches[m].second,
+                                          matches[m].second));
+            parents[root(matches[m].second)] = root(matches[m].first);
+        }
+        std::map<size_t, Clone> byRoot;
+        for (auto it = parents.begin(); it != parents.end(); ++it)
+        {
+            Clone& clone = byRoot[root(it->first)];
+            clone.ixs.push_back(firstMarkFrom(it->first));
+            clone.length = matches[begin].length;
+        }
+        for (auto it = byRoot.begin(); it != byRoot.end(); ++it)
+            if (it->second.ixs.size() >= itsMinInstances)
+                candidates.push_back(it->second);
+        begin = end;
+    }
+    // Like the bookmarks within a reported duplication when sorting, an
+    // instance that starts within an instance of a longer clone is dropped.
+    // If too few are left, or they are all in one part of the text, the rest
+    // of the clone is tried after the covered part instead.
+    auto isShorter = [](const Clone& a, const Clone& b) {
+        return a.length < b.length ||
+            (a.length == b.length && a.ixs[0] > b.ixs[0]);
+    };
+    std::priority_queue<Clone, std::vector<Clone>, decltype(isShorter)>
+        queue(isShorter, std::move(candidates));
+    std::vector<Clone> result;
+    IntervalSet        covered;
+    while (not queue.empty())
+    {
+        const Clone candidate = queue.top();
+        queue.pop();
+        Clone  clone;
+        size_t skip = 0;
+        clone.length = candidate.length;
+        for (size_t i = 0; i < candidate.ixs.size(); ++i)
+        {
+            const size_t offset = itsContainer.offset(candidate.ixs[i]);
+            const size_t end    = covered.endFrom(offset);
+            if (end == offset)
+                clone.ixs.push_back(candidate.ixs[i]);
+            else
+                skip = std::max(skip, end - offset);
+        }
+        bool isMixed = false;
+        for (size_t i = 1; i < clone.ixs.size() && not isMixed; ++i)
+            isMixed = itsContainer.isMixed(clone.ixs[0], clone.ixs[i]);
+        if (clone.ixs.size() < itsMinInstances || not isMixed)
+        {
+            if (shift(candidate, skip, clone))
+                queue.push(clone);
+            continue;
+        }
+        for (size_t i = 0; i < clone.ixs.size(); ++i)
+        {
+            const size_t offset = itsContainer.offset(clone.ixs[i]);
+            covered.insert(offset, offset + clone.length);
+        }
+        result.push_back(clone);
+    }
+    return result;
+}
+
+/**
+ * Sets the clone to what is left of another one from the first characters
+ * after skip where all of its instances are at a bookmark. Returns false if
+ * less than the minimum length is left.
+ */
+bool Winnower::shift(const Clone& clone, size_t skip, Clone& result) const
+{
+    const size_t first = itsContainer.offset(clone.ixs[0]);
+    for (size_t ix = firstMarkFrom(first + skip);
+         ix < itsContainer.size() &&
+             itsContainer.offset(ix) + itsMinLength <= first + clone.length;
+         ++ix)
+    {
+        const size_t delta   = itsContainer.offset(ix) - first;
+        bool         isAtAll = true;
+        for (size_t i = 1; i < clone.ixs.size() && isAtAll; ++i)
+            isAtAll = isMark(itsContainer.offset(clone.ixs[i]) + delta);
+        if (not isAtAll)
+            continue;
+        result.length = clone.length - delta;
+        result.ixs.clear();
+        for (size_t i = 0; i < clone.ixs.size(); ++i)
+            result.ixs.push_back(
+                firstMarkFrom(itsContainer.offset(clone.ixs[i]) + delta));
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Rolls the hash of the k-grams over the text and selects the rightmost
+ * smallest hash in each window, in text order. The windows are kept in a
+ * queue of increasing hashes, so each k-gram is handled in constant time on
+ * average.
+ */
+std::vector<Winnower::Fingerprint> Winnower::fingerprints() const
+{
+    const char*  text   = itsContainer.text();
+    const size_t k      = itsKgramLength;
+    uint64_t     power  = 1; // Of the first character in the k-gram.
+    for (size_t i = 0; i < k; ++i)
+        power *= HASH_BASE;
+
+    std::vector<Fingerprint> result;
+    std::deque<Fingerprint>  window;
+    uint64_t                 hash     = 0;
+    size_t                   run      = 0; // Characters since a file ended.
+    size_t                   selected = NONE;
+    for (size_t i = 0; text[i] != '\0'; ++i)
+    {
+        // No k-gram reaches across the end of a file.
+        if (text[i] == SPECIAL_EOF)
+        {
+            hash = 0;
+            run  = 0;
+            window.clear();
+            continue;
+        }
+        hash = hash * HASH_BASE + (unsigned char)text[i];
+        if (++run > k)
+            hash -= (unsigned char)text[i - k] * power;
+        if (run < k)
+            continue;
+
+        Fingerprint kgram;
+        kgram.hash   = hash;
+        kgram.offset = i + 1 - k;
+        while (not window.empty() && window.back().hash >= hash)
+            window.pop_back();
+        window.push_back(kgram);
+        if (window.front().offset + itsWindowLength <= kgram.offset)
+            window.pop_front();
+        if (run - k + 1 >= itsWindowLength &&
+            window.front().offset != selected)
+        {
+            selected = window.front().offset;
+            result.push_back(window.front());
+        }
+    }
+    return result;
+}
+
+/**
+ * Adds the pairs of places from begin up to end in the table, which share a
+ * fingerprint, to be expanded. Fingerprints that many places share are
+ * mostly boilerplate, so those places are sorted by their text instead and
+ * only neighbors are paired.
+ */
+void Winnower::addPairs(const std::vector<Fingerprint>& table,
+                        size_t                          begin,
+                        size_t                          end,
+                        std::vector<Match>&             pairs) const
+{
+    Match pair;
+    pair.length = 0;
+    if (end - begin <= MAX_PAIRED_PLACES)
+    {
+        for (size_t a = begin; a < end; ++a)
+            for (size_t b = a + 1; b < end; ++b)
+                if (itsContainer.isMixedAt(table[a].offset, table[b].offset))
+                {
+                    pair.first  = table[a].offset;
+                    pair.second = table[b].offset;
+                    pairs.push_back(pair);
+                }
+        return;
+    }
+
+    const char*         text = itsContainer.text();
+    std::vector<size_t> offsets;
+    for (size_t f = begin; f < end; ++f)
+        offsets.push_back(table[f].offset);
+    std::stable_sort(offsets.begin(), offsets.end(), [&](size_t a, size_t b) {
+        return strncmp(text + a, text + b, itsMinLength) < 0;
+    });
+    for (size_t i = 0; i + 1 < offsets.size(); ++i)
+    {
+        if (not itsContainer.isMixedAt(offsets[i], offsets[i + 1]))
+            continue;
+        pair.first  = offsets[i];
+        pair.second = offsets[i + 1];
+        if (pair.first > pair.second)
+            std::swap(pair.first, pair.second);
+        pairs.push_back(pair);
+    }
+}
+
+/**
+ * Expands the pairs into maximal matches that start at a bookmark in both
+ * instances and keeps those that are long enough. Pairs within a match that
+ * has been expanded already on the same diagonal, i.e., with the same
+ * distance between the instances, are skipped.
+ */
+void Winnower::expand(std::vector<Match>& pairs)
+{
+    std::sort(pairs.begin(), pairs.end(), [](const Match& a, const Match& b) {
+        const size_t diagonalA = a.second - a.first;
+        const size_t diagonalB = b.second - b.first;
+        return diagonalA < diagonalB ||
+            (diagonalA == diagonalB && a.first < b.first);
+    });
+
+    const char* text         = itsContainer.text();
+    size_t      lastDiagonal = NONE;
+    size_t      lastEnd      = 0;
+    for (size_t p = 0; p < pairs.size(); ++p)
+    {
+        const size_t diagonal = pairs[p].second - pairs[p].first;
+        if (diagonal == lastDiagonal && pairs[p].first < lastEnd)
+            continue;
+
+        size_t begin = pairs[p].first;
+        while (begin > 0 && text[begin - 1] != SPECIAL_EOF &&
+               text[begin - 1] == text[begin - 1 + diagonal])
+        {
+            --begin;
+        }
+        size_t end = pairs[p].first;
+        while (text[end] != '\0' && text[end] != SPECIAL_EOF &&
+               text[end] == text[end + diagonal])
+        {
+            ++end;
+        }
+        lastDiagonal = diagonal;
+        lastEnd      = end;
+
+        size_t ix = firstMarkFrom(begin);
+        while (ix < itsContainer.size() && itsContainer.offset(ix) < end &&
+               not isMark(itsContainer.offset(ix) + diagonal))
+        {
+            ++ix;
+        }
+        if (ix == itsContainer.size() || itsContainer.offset(ix) >= end ||
+            end - itsContainer.offset(ix) < itsMinLength)
+        {
+            continue;
+        }
+        Match match;
+        match.first  = itsContainer.offset(ix);
+        match.second = match.first + diagonal;
+        match.length = end - match.first;
+        itsMatches.push_back(match);
+    }
+}
+
+// Returns the index of the first bookmark at or after the offset.
+size_t Winnower::firstMarkFrom(size_t offset) const
+{
+    size_t low  = 0;
+    size_t high = itsContainer.size();
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (itsContainer.offset(middle) < offset)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+bool Winnower::isMark(size_t offset) const
+{
+    const size_t ix = firstMarkFrom(offset);
+    return ix < itsContainer.size() && itsContainer.offset(ix) == offset;
+}
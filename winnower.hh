@@ -0,0 +1,93 @@
+#ifndef WINNOWER_HH
+#define WINNOWER_HH
+
+#include <cstdint>
+#include <cstdlib> // size_t
+#include <vector>
+
+class BookmarkContainer;
+
+/**
+ * Finds duplications from fingerprints of the processed text instead of
+ * sorting the bookmarks, which takes far less memory and time for corpora of
+ * many repositories. This is the winnowing of Schleimer, Wilkerson and Aiken,
+ * which is used by MOSS.
+ *
+ * The hash of each k-gram, i.e., each run of k characters within a file, is
+ * rolled over the text in one pass. In each window of w consecutive k-grams,
+ * the one with the smallest hash is selected as a fingerprint. Any match of
+ * at least w + k - 1 characters covers a whole window, so both of its
+ * instances select the same fingerprint. The fingerprints are sorted by hash
+ * into a table, and places that share one are expanded by comparing their
+ * text into maximal matches. These start at the first bookmark within them,
+ * so every duplication of at least minLength characters from a bookmark is
+ * found within one of them.
+ */
+class Winnower
+{
+public:
+    struct Clone
+    {
+        std::vector<size_t> ixs; // Of the bookmark at each instance.
+        size_t              length;
+    };
+
+    // The container must not be sorted, so that its bookmarks are in text
+    // order. Clones with fewer than minInstances instances are left out.
+    Winnower(const BookmarkContainer& container,
+             size_t                   minLength,
+             size_t                   minInstances = 2);
+
+    // The k-grams are this long, unless the minimum length is shorter.
+    static const size_t KGRAM_LENGTH = 20;
+
+    // Places that share a fingerprint are all compared with each other, up to
+    // this many. Beyond that only neighbors in the order of their text are,
+    // like the bookmarks after sorting.
+    static const size_t MAX_PAIRED_PLACES = 16;
+
+    size_t kgramLength() const { return itsKgramLength; }
+    size_t windowLength() const { return itsWindowLength; }
+    size_t nrOfFingerprints() const { return itsNrOfFingerprints; }
+
+    /**
+     * Returns the clones, longest first. The instances of a clone all have
+     * the same text, and none of them starts within an instance of a longer
+     * clone.
+     */
+    std::vector<Clone> clones() const;
+
+private:
+    struct Fingerprint
+    {
+        uint64_t hash;
+        size_t   offset;
+    };
+
+    struct Match
+    {
+        size_t first;   // Offsets of the two instances, first < second.
+        size_t second;
+        size_t length;
+    };
+
+    std::vector<Fingerprint> fingerprints() const;
+    void   addPairs(const std::vector<Fingerprint>& fingerprints,
+                    size_t                          begin,
+                    size_t                          end,
+                    std::vector<Match>&             pairs) const;
+    void   expand(std::vector<Match>& pairs);
+    bool   shift(const Clone& clone, size_t skip, Clone& result) const;
+    size_t firstMarkFrom(size_t offset) const;
+    bool   isMark(size_t offset) const;
+
+    const BookmarkContainer& itsContainer;
+    const size_t             itsMinLength;
+    const size_t             itsMinInstances;
+    size_t                   itsKgramLength;
+    size_t                   itsWindowLength;
+    size_t                   itsNrOfFingerprints;
+    std::vector<Match>       itsMatches;
+};
+
+#endif